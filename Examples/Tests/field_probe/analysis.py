@@ -16,15 +16,57 @@ wave undergoes diffraction at the slit. The electromagnetic flux is calculated
 at the line detector which is placed perpendicular to Z beyond the slit. This
 test will check if the detected EM flux matches expected values,
 which can be solved analytically.
+The same line of detector points is also written with openPMD, and the test
+checks that the openPMD records match the text output point by point, the
+text output being sorted by the id (index) of the points.
 """
 
 import numpy as np
+import openpmd_api as io
 import pandas as pd
 
 filename = "diags/reducedfiles/FP_line.txt"
 
 # Open data file
 df = pd.read_csv(filename, sep=" ")
+
+# Compare the openPMD output of the same probe with the text output
+series = io.Series(
+    "diags/reducedfiles/FP_line_openpmd/openpmd_%T.h5", io.Access.read_only
+)
+steps = [int(step) for step in df["[0]step()"].unique()]
+assert sorted(series.iterations) == sorted(steps)
+# columns of the text output after step and time
+records = [
+    ("position", "x"),
+    ("position", "y"),
+    ("position", "z"),
+    ("E", "x"),
+    ("E", "y"),
+    ("E", "z"),
+    ("B", "x"),
+    ("B", "y"),
+    ("B", "z"),
+    ("S", io.Record_Component.SCALAR),
+]
+for step in steps:
+    text = df[df["[0]step()"] == step].to_numpy()[:, 2:]
+    probe = series.iterations[step].particles["probe"]
+    data = [probe["id"][io.Record_Component.SCALAR].load_chunk()]
+    data += [probe[r][c].load_chunk() for r, c in records]
+    series.flush()
+    # the ids are the indices of the points, starting at 1
+    order = np.argsort(data[0])
+    assert np.array_equal(data[0][order], np.arange(1, text.shape[0] + 1))
+    for icol, (r, c) in enumerate(records):
+        values = data[icol + 1][order]
+        error = np.max(np.abs(values - text[:, icol]))
+        print(f"step {step}, {r} {c}: max difference {error}")
+        # the text output has 15 significant digits
+        assert np.allclose(
+            values, text[:, icol], rtol=1e-13, atol=1e-13 * np.max(np.abs(values))
+        )
+
 df = df.sort_values(by=["[2]part_x_lev0-(m)"])
 
 # Select position and Intensity of timestep 500
@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+This script tests the FieldSpectrum reduced diagnostics in a periodic domain,
+where the field is initialized with a single Fourier mode.
+It checks that:
+- the sum of the radial bins (which cover the whole k-grid by default) equals the
+  mean of the squared field over the domain (Parseval), computed from the
+  (cell-centered) fields of the plotfile written at the same step;
+- the spectrum is concentrated in the bin of the wave vector of the mode.
+"""
+
+import numpy as np
+import pandas as pd
+import yt
+
+yt.funcs.mylog.setLevel(50)
+
+kabs = 2 * np.pi * 5  # |(3, 4)|*2*pi
+fields = ["Ey", "Bz"]
+
+df = pd.read_csv("diags/reducedfiles/FS.txt", sep=" ")
+columns = {f: [c for c in df.columns if f"]{f}_k=" in c] for f in fields}
+nbins = len(columns["Ey"])
+# the header gives the center of the bins
+k_centers = np.array([float(c.split("_k=")[1].split("(")[0]) for c in columns["Ey"]])
+bin_size = 2 * k_centers[0]
+peak_bin = int(np.floor(kabs / bin_size))
+
+for _, row in df.iterrows():
+    step = int(row["#[0]step()"])
+    ds = yt.load(f"diags/diag1{step:06d}")
+    cg = ds.covering_grid(
+        level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions
+    )
+    for f in fields:
+        spectrum = row[columns[f]].to_numpy(dtype=float)
+        mean_f2 = np.mean(cg[("boxlib", f)].to_ndarray() ** 2)
+        print(f"step {step}, {f}: sum of bins = {spectrum.sum()}, <F^2> = {mean_f2}")
+        assert np.isclose(spectrum.sum(), mean_f2, rtol=1e-10)
+        print(f"  fraction in bin {peak_bin}: {spectrum[peak_bin] / spectrum.sum()}")
+        assert np.argmax(spectrum) == peak_bin
+        assert spectrum[peak_bin] > (1 - 1e-10) * spectrum.sum()
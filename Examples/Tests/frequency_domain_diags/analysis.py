@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+This script tests the FrequencyDomain diagnostics with a standing wave in a periodic domain.
+The field oscillates as Ey(x, t) = A(x) cos(omega t), where omega is given by the numerical
+dispersion relation of the Yee scheme, so the running transforms accumulated from t = 0 to
+the last step must be A(x) sum_n cos(omega t_n) exp(-2 i pi f t_n) dt at each frequency f.
+The profile A(x) (interpolated at the cell centers) is taken from the Full diagnostics at step 0.
+"""
+
+import numpy as np
+import yt
+from scipy.constants import c
+
+yt.funcs.mylog.setLevel(50)
+
+kx = 2 * np.pi
+frequencies = [c, 2 * c]
+max_step = 200
+
+
+def load(name, step):
+    ds = yt.load(f"diags/{name}{step:06d}")
+    cg = ds.covering_grid(
+        level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions
+    )
+    return ds, cg
+
+
+ds0, cg0 = load("diag1", 0)
+profile = cg0[("boxlib", "Ey")].to_ndarray()
+
+ds, cg = load("dft", max_step)
+dt = float(ds.current_time) / max_step
+dx = float(ds.domain_width[0]) / int(ds.domain_dimensions[0])
+
+# numerical frequency of the Yee scheme for a wave along x
+omega = 2.0 / dt * np.arcsin(c * dt / dx * np.sin(kx * dx / 2))
+t = dt * np.arange(max_step + 1)
+
+for i, f in enumerate(frequencies):
+    expected = np.sum(np.cos(omega * t) * np.exp(-2j * np.pi * f * t)) * dt
+    dft = (
+        cg[("boxlib", f"Ey_dft{i}_real")].to_ndarray()
+        + 1j * cg[("boxlib", f"Ey_dft{i}_imag")].to_ndarray()
+    )
+    error = np.max(np.abs(dft - expected * profile)) / np.max(
+        np.abs(expected * profile)
+    )
+    print(f"frequency {f:.6e} Hz: analytic transform {expected}, relative error {error}")
+    assert error < 1e-8
+
+# the transform at the frequency of the wave is larger than at twice this frequency
+amplitude = [
+    np.max(
+        np.hypot(
+            cg[("boxlib", f"Ey_dft{i}_real")].to_ndarray(),
+            cg[("boxlib", f"Ey_dft{i}_imag")].to_ndarray(),
+        )
+    )
+    for i in range(len(frequencies))
+]
+print(f"amplitudes: {amplitude}")
+assert amplitude[0] > amplitude[1]
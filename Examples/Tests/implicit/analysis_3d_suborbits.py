@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+#
+# This is a script that analyses the simulation results from the script
+# `inputs_test_3d_theta_implicit_jfnk_suborbits`. A single electron gyrates in a
+# uniform magnetic field, with a gyro-phase advance of 2 radians per time step.
+# With 20 suborbits per step, the momentum and the position of the electron must
+# follow the analytic orbit. Without suborbits, the implicit (Crank-Nicolson) push
+# would rotate the momentum by 2*atan(1) instead of 2 radians at each step.
+
+import numpy as np
+import yt
+from scipy.constants import c, e, m_e
+
+yt.funcs.mylog.setLevel(50)
+
+B0 = 1.0
+u0 = 0.01
+max_step = 10
+gamma = np.sqrt(1.0 + u0**2)
+# signed gyro-frequency of the electron
+omega = -e * B0 / (m_e * gamma)
+rL = u0 * c / abs(omega)
+
+# tolerance on the orbit: the phase error of the suborbits is about
+# 20*(0.1)**3/12 radian per step, i.e. less than 0.02 radian after 10 steps
+tolerance = 0.05
+
+for step in range(1, max_step + 1):
+    ds = yt.load(f"diags/diag1{step:06d}")
+    ad = ds.all_data()
+    t = float(ds.current_time)
+    x = ad[("electrons", "particle_position_x")].to_ndarray()[0]
+    y = ad[("electrons", "particle_position_y")].to_ndarray()[0]
+    z = ad[("electrons", "particle_position_z")].to_ndarray()[0]
+    ux = ad[("electrons", "particle_momentum_x")].to_ndarray()[0] / (m_e * c)
+    uy = ad[("electrons", "particle_momentum_y")].to_ndarray()[0] / (m_e * c)
+    uz = ad[("electrons", "particle_momentum_z")].to_ndarray()[0] / (m_e * c)
+
+    # analytic orbit, with du/dt = omega u x z
+    phase = omega * t
+    ux_th = u0 * np.cos(phase)
+    uy_th = -u0 * np.sin(phase)
+    x_th = u0 * c * np.sin(phase) / (gamma * omega)
+    y_th = u0 * c * (np.cos(phase) - 1.0) / (gamma * omega)
+
+    error_u = np.hypot(ux - ux_th, uy - uy_th) / u0
+    error_x = np.hypot(x - x_th, y - y_th) / rL
+    print(f"step {step}: momentum error {error_u:.3e}, position error {error_x:.3e}")
+    assert error_u < tolerance
+    assert error_x < tolerance
+    assert abs(uz) < 1e-12 * u0
+    assert abs(z) < 1e-12 * rL
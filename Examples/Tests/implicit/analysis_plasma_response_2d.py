@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+#
+# This is a script that analyses the simulation results from the script
+# `inputs_test_2d_theta_implicit_jfnk_vandb_plasma_response`, which reruns
+# `inputs_test_2d_theta_implicit_jfnk_vandb` with the linearized plasma response in
+# the Jacobian and in the preconditioner of the Newton solver. Since only the linear
+# solves are changed, the Newton solver must converge to the same solution as the
+# test that pushes and deposits the particles in each Jacobian evaluation.
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(50)
+
+reference_dir = "../test_2d_theta_implicit_jfnk_vandb"
+tolerance = 1e-6
+
+# energy history
+for name in ["field_energy", "particle_energy"]:
+    energy = np.loadtxt(f"diags/reducedfiles/{name}.txt", skiprows=1)
+    reference = np.loadtxt(f"{reference_dir}/diags/reducedfiles/{name}.txt", skiprows=1)
+    error = np.max(np.abs(energy[:, 2] - reference[:, 2])) / np.max(reference[:, 2])
+    print(f"{name}: relative difference {error}")
+    assert error < tolerance
+
+# fields at the last step
+pltdir = sys.argv[1]
+ds = yt.load(pltdir)
+ds_ref = yt.load(f"{reference_dir}/{pltdir}")
+data = ds.covering_grid(
+    level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions
+)
+data_ref = ds_ref.covering_grid(
+    level=0, left_edge=ds_ref.domain_left_edge, dims=ds_ref.domain_dimensions
+)
+for field in ["Ex", "Ey", "Ez", "Bx", "By", "Bz", "jx", "jy", "jz", "rho"]:
+    f = data["boxlib", field].value
+    f_ref = data_ref["boxlib", field].value
+    error = np.max(np.abs(f - f_ref)) / np.max(np.abs(f_ref))
+    print(f"{field}: relative difference {error}")
+    assert error < tolerance
@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script tests the option fuse_with_push of the ParticleEnergy and
+# ParticleMomentum reduced diagnostics.
+# The setup is a uniform plasma with electrons, protons and photons, in a periodic
+# box or, with the argument --absorbing, in a box with absorbing particle boundaries.
+# The same diagnostics are computed at each step during the particle push
+# (fuse_with_push = 1) and with a separate pass over the particles: both must agree
+# up to the summation order. With absorbing boundaries, where particles are removed
+# after the push, the fused diagnostics fall back to the separate pass.
+
+import sys
+
+import numpy as np
+
+rtol = 1e-10
+
+if "--absorbing" in sys.argv[1:]:
+    # check that particles were removed at the boundaries during the run
+    number = np.genfromtxt("./diags/reducedfiles/PN.txt")
+    print(f"macroparticles: {number[0, 2]} at step 1, {number[-1, 2]} at the end")
+    assert number[-1, 2] < number[0, 2]
+
+error = False
+for name in ["EP", "PP"]:
+    regular = np.genfromtxt(f"./diags/reducedfiles/{name}.txt")
+    fused = np.genfromtxt(f"./diags/reducedfiles/{name}_fused.txt")
+    assert regular.shape == fused.shape
+    # step and time
+    assert np.array_equal(regular[:, :2], fused[:, :2])
+    # the momentum along y vanishes on average: use the scale of each column
+    scale = np.max(np.abs(regular[:, 2:]), axis=0)
+    scale[scale == 0] = 1
+    diff = np.max(np.abs(fused[:, 2:] - regular[:, 2:]), axis=0) / scale
+    print(f"{name}: max relative difference = {np.max(diff)}")
+    error = error or np.max(diff) > rtol
+
+sys.exit(1 if error else 0)
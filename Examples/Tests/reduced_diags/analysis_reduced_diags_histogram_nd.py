@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script tests the ParticleHistogramND reduced diagnostics.
+# Two 2D histograms (one of them with a filter and a value function) are filled
+# by a single ParticleHistogramND and by two ParticleHistogram2D, which must agree
+# up to the summation order.
+# The axes of ParticleHistogramND are stored from the slowest to the fastest varying,
+# i.e. (ordinate, abscissa) as for ParticleHistogram2D.
+
+import sys
+
+import numpy as np
+import openpmd_api as io
+
+rtol = 1e-12
+
+
+def load(series_name, mesh_name):
+    series = io.Series(
+        f"diags/reducedfiles/{series_name}/openpmd_%T.h5", io.Access.read_only
+    )
+    data = dict()
+    for step, it in series.iterations.items():
+        mesh = it.meshes[mesh_name][io.Mesh_Record_Component.SCALAR]
+        values = mesh.load_chunk()
+        series.flush()
+        data[step] = values
+    return data
+
+
+error = False
+for name in ["zuz", "xux"]:
+    hist_nd = load("HND", name)
+    hist_2d = load(f"H2D_{name}", "data")
+    assert sorted(hist_nd.keys()) == sorted(hist_2d.keys())
+    for step in hist_2d:
+        assert hist_nd[step].shape == hist_2d[step].shape
+        scale = np.max(np.abs(hist_2d[step]))
+        assert scale > 0
+        diff = np.max(np.abs(hist_nd[step] - hist_2d[step])) / scale
+        print(f"{name}, step {step}: max relative difference = {diff}")
+        error = error or diff > rtol
+
+sys.exit(1 if error else 0)
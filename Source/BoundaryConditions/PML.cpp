@@ -145,7 +145,8 @@ namespace
 }
 
 
-SigmaBox::SigmaBox (const Box& box, const BoxArray& grids, const Real* dx, const IntVect& ncell,
+SigmaBox::SigmaBox (const Box& box, const BoxArray& grids, const Real* dx,
+                    const IntVect& ncell_lo, const IntVect& ncell_hi,
                     const IntVect& delta, const amrex::Box& regdomain, const amrex::Real v_sigma_sb)
 {
     BL_ASSERT(box.cellCentered());
@@ -189,13 +190,16 @@ SigmaBox::SigmaBox (const Box& box, const BoxArray& grids, const Real* dx, const
     }
 
     if (regdomain.ok()) { // The union of the regular grids is a single box
-        define_single(regdomain, ncell, fac, v_sigma_sb);
+        define_single(regdomain, ncell_lo, ncell_hi, fac, v_sigma_sb);
     } else {
-        define_multiple(box, grids, ncell, fac, v_sigma_sb);
+        // The sigma profiles only depend on the distance to the grids, hence
+        // the largest depth can be used to find the grids near this box
+        define_multiple(box, grids, amrex::max(ncell_lo, ncell_hi), fac, v_sigma_sb);
     }
 }
 
-void SigmaBox::define_single (const Box& regdomain, const IntVect& ncell,
+void SigmaBox::define_single (const Box& regdomain,
+                              const IntVect& ncell_lo, const IntVect& ncell_hi,
                               const Array<Real,AMREX_SPACEDIM>& fac,
                               const amrex::Real v_sigma_sb)
 {
@@ -206,7 +210,7 @@ void SigmaBox::define_single (const Box& regdomain, const IntVect& ncell,
         const int dhi = regdomain.bigEnd(idim);
 
         // Lo
-        int olo = std::max(slo, dlo-ncell[idim]);
+        int olo = std::max(slo, dlo-ncell_lo[idim]);
         int ohi = std::min(shi, dlo-1);
         if (ohi >= olo) {
             FillLo(sigma[idim], sigma_cumsum[idim],
@@ -227,7 +231,7 @@ void SigmaBox::define_single (const Box& regdomain, const IntVect& ncell,
 
         // Hi
         olo = std::max(slo, dhi+1);
-        ohi = std::min(shi, dhi+ncell[idim]);
+        ohi = std::min(shi, dhi+ncell_hi[idim]);
         if (ohi >= olo) {
             FillHi(sigma[idim], sigma_cumsum[idim],
                    sigma_star[idim], sigma_star_cumsum[idim],
@@ -507,10 +511,11 @@ SigmaBox::ComputePMLFactorsE (const Real* a_dx, Real dt)
 
 MultiSigmaBox::MultiSigmaBox (const BoxArray& ba, const DistributionMapping& dm,
                               const BoxArray& grid_ba, const Real* dx,
-                              const IntVect& ncell, const IntVect& delta,
+                              const IntVect& ncell_lo, const IntVect& ncell_hi,
+                              const IntVect& delta,
                               const amrex::Box& regular_domain, const amrex::Real v_sigma_sb)
     : FabArray<SigmaBox>(ba,dm,1,0,MFInfo(),
-                         SigmaBoxFactory(grid_ba,dx,ncell,delta, regular_domain, v_sigma_sb))
+                         SigmaBoxFactory(grid_ba,dx,ncell_lo,ncell_hi,delta, regular_domain, v_sigma_sb))
 {}
 
 void
@@ -548,10 +553,11 @@ MultiSigmaBox::ComputePMLFactorsE (const Real* dx, Real dt)
 PML::PML (const int lev, const BoxArray& grid_ba,
           const DistributionMapping& grid_dm, const bool do_similar_dm_pml,
           const Geometry* geom, const Geometry* cgeom,
-          int ncell, int delta, amrex::IntVect ref_ratio,
+          const amrex::IntVect& ncell_lo, const amrex::IntVect& ncell_hi,
+          int delta, amrex::IntVect ref_ratio,
           Real dt, int nox_fft, int noy_fft, int noz_fft,
           ablastr::utils::enums::GridType grid_type,
-          int do_moving_window, int /*pml_has_particles*/, int do_pml_in_domain,
+          int do_moving_window, int pml_has_particles, int do_pml_in_domain,
           const PSATDSolutionType psatd_solution_type,
           const JInTime J_in_time, const RhoInTime rho_in_time,
           const bool do_pml_dive_cleaning, const bool do_pml_divb_cleaning,
@@ -592,8 +598,8 @@ PML::PML (const int lev, const BoxArray& grid_ba,
                     // the size by ncells using growLo(idim,-ncell)
                     Box const& bb = amrex::adjCellLo(b, idim);
                     if ( ! grid_ba.intersects(bb) ) {
-                        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(b.length(idim) > ncell, " box length must be greater that pml size");
-                        b.growLo(idim, -ncell);
+                        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(b.length(idim) > ncell_lo[idim], " box length must be greater that pml size");
+                        b.growLo(idim, -ncell_lo[idim]);
                     }
                 }
                 if (do_pml_Hi[idim]) {
@@ -602,8 +608,8 @@ PML::PML (const int lev, const BoxArray& grid_ba,
                     // the size by ncells using growHi(idim,-ncell)
                     Box const& bb = amrex::adjCellHi(b, idim);
                     if ( ! grid_ba.intersects(bb) ) {
-                        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(b.length(idim) > ncell, " box length must be greater that pml size");
-                        b.growHi(idim, -ncell);
+                        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(b.length(idim) > ncell_hi[idim], " box length must be greater that pml size");
+                        b.growHi(idim, -ncell_hi[idim]);
                     }
                 }
             }
@@ -613,7 +619,7 @@ PML::PML (const int lev, const BoxArray& grid_ba,
     Box const domain0 = grid_ba_reduced.minimalBox();
     const bool is_single_box_domain = domain0.numPts() == grid_ba_reduced.numPts();
     const BoxArray& ba = MakeBoxArray(is_single_box_domain, domain0, *geom, grid_ba_reduced,
-                                      IntVect(ncell), do_pml_in_domain, do_pml_Lo, do_pml_Hi);
+                                      ncell_lo, ncell_hi, do_pml_in_domain, do_pml_Lo, do_pml_Hi);
 
 
     if (ba.empty()) {
@@ -717,12 +723,15 @@ PML::PML (const int lev, const BoxArray& grid_ba,
     warpx.m_fields.alloc_init(FieldType::pml_B_fp, Direction{1}, lev, ba_By, dm, ncompb, ngb, 0.0_rt, false, false);
     warpx.m_fields.alloc_init(FieldType::pml_B_fp, Direction{2}, lev, ba_Bz, dm, ncompb, ngb, 0.0_rt, false, false);
 
-    const amrex::BoxArray ba_jx = amrex::convert(ba, WarpX::GetInstance().m_fields.get(FieldType::current_fp, Direction{0}, 0)->ixType().toIntVect());
-    const amrex::BoxArray ba_jy = amrex::convert(ba, WarpX::GetInstance().m_fields.get(FieldType::current_fp, Direction{1}, 0)->ixType().toIntVect());
-    const amrex::BoxArray ba_jz = amrex::convert(ba, WarpX::GetInstance().m_fields.get(FieldType::current_fp, Direction{2}, 0)->ixType().toIntVect());
-    warpx.m_fields.alloc_init(FieldType::pml_j_fp, Direction{0}, lev, ba_jx, dm, 1, ngb, 0.0_rt, false, false);
-    warpx.m_fields.alloc_init(FieldType::pml_j_fp, Direction{1}, lev, ba_jy, dm, 1, ngb, 0.0_rt, false, false);
-    warpx.m_fields.alloc_init(FieldType::pml_j_fp, Direction{2}, lev, ba_jz, dm, 1, ngb, 0.0_rt, false, false);
+    // The current in the PML is only deposited by the particles that enter the PML
+    if (pml_has_particles) {
+        const amrex::BoxArray ba_jx = amrex::convert(ba, WarpX::GetInstance().m_fields.get(FieldType::current_fp, Direction{0}, 0)->ixType().toIntVect());
+        const amrex::BoxArray ba_jy = amrex::convert(ba, WarpX::GetInstance().m_fields.get(FieldType::current_fp, Direction{1}, 0)->ixType().toIntVect());
+        const amrex::BoxArray ba_jz = amrex::convert(ba, WarpX::GetInstance().m_fields.get(FieldType::current_fp, Direction{2}, 0)->ixType().toIntVect());
+        warpx.m_fields.alloc_init(FieldType::pml_j_fp, Direction{0}, lev, ba_jx, dm, 1, ngb, 0.0_rt, false, false);
+        warpx.m_fields.alloc_init(FieldType::pml_j_fp, Direction{1}, lev, ba_jy, dm, 1, ngb, 0.0_rt, false, false);
+        warpx.m_fields.alloc_init(FieldType::pml_j_fp, Direction{2}, lev, ba_jz, dm, 1, ngb, 0.0_rt, false, false);
+    }
 
 #ifdef AMREX_USE_EB
     if (eb_enabled) {
@@ -765,7 +774,7 @@ PML::PML (const int lev, const BoxArray& grid_ba,
     Box single_domain_box = is_single_box_domain ? domain0 : Box();
     // Empty box (i.e., Box()) means it's not a single box domain.
     sigba_fp = std::make_unique<MultiSigmaBox>(ba, dm, grid_ba_reduced, geom->CellSize(),
-                                               IntVect(ncell), IntVect(delta), single_domain_box, v_sigma_sb);
+                                               ncell_lo, ncell_hi, IntVect(delta), single_domain_box, v_sigma_sb);
 
     if (WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::PSATD) {
 #ifndef WARPX_USE_FFT
@@ -812,13 +821,13 @@ PML::PML (const int lev, const BoxArray& grid_ba,
                     if (do_pml_Lo[idim]) {
                         Box const& bb = amrex::adjCellLo(b, idim);
                         if ( ! grid_cba.intersects(bb) ) {
-                            b.growLo(idim, -ncell/ref_ratio[idim]);
+                            b.growLo(idim, -ncell_lo[idim]/ref_ratio[idim]);
                         }
                     }
                     if (do_pml_Hi[idim]) {
                         Box const& bb = amrex::adjCellHi(b, idim);
                         if ( ! grid_cba.intersects(bb) ) {
-                            b.growHi(idim, -ncell/ref_ratio[idim]);
+                            b.growHi(idim, -ncell_hi[idim]/ref_ratio[idim]);
                         }
                     }
                 }
@@ -827,12 +836,13 @@ PML::PML (const int lev, const BoxArray& grid_ba,
         }
         Box const cdomain = grid_cba_reduced.minimalBox();
 
-        const IntVect cncells = IntVect(ncell)/ref_ratio;
+        const IntVect cncells_lo = ncell_lo/ref_ratio;
+        const IntVect cncells_hi = ncell_hi/ref_ratio;
         const IntVect cdelta = IntVect(delta)/ref_ratio;
 
         // Assuming that refinement ratio is equal in all dimensions
         const BoxArray& cba = MakeBoxArray(is_single_box_domain, cdomain, *cgeom, grid_cba_reduced,
-                                           cncells, do_pml_in_domain, do_pml_Lo, do_pml_Hi);
+                                           cncells_lo, cncells_hi, do_pml_in_domain, do_pml_Lo, do_pml_Hi);
         DistributionMapping cdm;
         if (do_similar_dm_pml) {
             auto ng_sim = amrex::elemwiseMax(amrex::elemwiseMax(nge, ngb), ngf);
@@ -871,16 +881,18 @@ PML::PML (const int lev, const BoxArray& grid_ba,
             warpx.m_fields.alloc_init(FieldType::pml_G_cp, lev, cba_G_nodal, cdm, 3, ngf, 0.0_rt, false, false);
         }
 
-        const amrex::BoxArray cba_jx = amrex::convert(cba, WarpX::GetInstance().m_fields.get(FieldType::current_cp, Direction{0}, 1)->ixType().toIntVect());
-        const amrex::BoxArray cba_jy = amrex::convert(cba, WarpX::GetInstance().m_fields.get(FieldType::current_cp, Direction{1}, 1)->ixType().toIntVect());
-        const amrex::BoxArray cba_jz = amrex::convert(cba, WarpX::GetInstance().m_fields.get(FieldType::current_cp, Direction{2}, 1)->ixType().toIntVect());
-        warpx.m_fields.alloc_init(FieldType::pml_j_cp, Direction{0}, lev, cba_jx, cdm, 1, ngb, 0.0_rt, false, false);
-        warpx.m_fields.alloc_init(FieldType::pml_j_cp, Direction{1}, lev, cba_jy, cdm, 1, ngb, 0.0_rt, false, false);
-        warpx.m_fields.alloc_init(FieldType::pml_j_cp, Direction{2}, lev, cba_jz, cdm, 1, ngb, 0.0_rt, false, false);
+        if (pml_has_particles) {
+            const amrex::BoxArray cba_jx = amrex::convert(cba, WarpX::GetInstance().m_fields.get(FieldType::current_cp, Direction{0}, 1)->ixType().toIntVect());
+            const amrex::BoxArray cba_jy = amrex::convert(cba, WarpX::GetInstance().m_fields.get(FieldType::current_cp, Direction{1}, 1)->ixType().toIntVect());
+            const amrex::BoxArray cba_jz = amrex::convert(cba, WarpX::GetInstance().m_fields.get(FieldType::current_cp, Direction{2}, 1)->ixType().toIntVect());
+            warpx.m_fields.alloc_init(FieldType::pml_j_cp, Direction{0}, lev, cba_jx, cdm, 1, ngb, 0.0_rt, false, false);
+            warpx.m_fields.alloc_init(FieldType::pml_j_cp, Direction{1}, lev, cba_jy, cdm, 1, ngb, 0.0_rt, false, false);
+            warpx.m_fields.alloc_init(FieldType::pml_j_cp, Direction{2}, lev, cba_jz, cdm, 1, ngb, 0.0_rt, false, false);
+        }
 
         single_domain_box = is_single_box_domain ? cdomain : Box();
         sigba_cp = std::make_unique<MultiSigmaBox>(cba, cdm, grid_cba_reduced, cgeom->CellSize(),
-                                                   cncells, cdelta, single_domain_box, v_sigma_sb);
+                                                   cncells_lo, cncells_hi, cdelta, single_domain_box, v_sigma_sb);
 
         if (WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::PSATD) {
 #ifndef WARPX_USE_FFT
@@ -911,20 +923,21 @@ PML::PML (const int lev, const BoxArray& grid_ba,
 BoxArray
 PML::MakeBoxArray (bool is_single_box_domain, const amrex::Box& regular_domain,
                    const amrex::Geometry& geom, const amrex::BoxArray& grid_ba,
-                   const amrex::IntVect& ncell, int do_pml_in_domain,
+                   const amrex::IntVect& ncell_lo, const amrex::IntVect& ncell_hi,
+                   int do_pml_in_domain,
                    const amrex::IntVect& do_pml_Lo, const amrex::IntVect& do_pml_Hi)
 {
     if (is_single_box_domain) {
-        return MakeBoxArray_single(regular_domain, grid_ba, ncell, do_pml_Lo, do_pml_Hi);
+        return MakeBoxArray_single(regular_domain, grid_ba, ncell_lo, ncell_hi, do_pml_Lo, do_pml_Hi);
     } else { // the union of the regular grids is *not* a single rectangular domain
-        return MakeBoxArray_multiple(geom, grid_ba, ncell, do_pml_in_domain, do_pml_Lo, do_pml_Hi);
+        return MakeBoxArray_multiple(geom, grid_ba, ncell_lo, ncell_hi, do_pml_in_domain, do_pml_Lo, do_pml_Hi);
     }
 }
 
 BoxArray
 PML::MakeBoxArray_single (const amrex::Box& regular_domain, const amrex::BoxArray& grid_ba,
-                          const amrex::IntVect& ncell, const amrex::IntVect& do_pml_Lo,
-                          const amrex::IntVect& do_pml_Hi)
+                          const amrex::IntVect& ncell_lo, const amrex::IntVect& ncell_hi,
+                          const amrex::IntVect& do_pml_Lo, const amrex::IntVect& do_pml_Hi)
 {
     BoxList bl;
     const auto grid_ba_size = static_cast<int>(grid_ba.size());
@@ -943,15 +956,15 @@ PML::MakeBoxArray_single (const amrex::Box& regular_domain, const amrex::BoxArra
                 pml_bndry = b.bigEnd(idim) == regular_domain.bigEnd(idim);
             }
             if (pml_bndry) {
-                Box bbox = amrex::adjCell(b, ori, ncell[idim]);
+                Box bbox = amrex::adjCell(b, ori, ori.isLow() ? ncell_lo[idim] : ncell_hi[idim]);
                 for (int jdim = 0; jdim < idim; ++jdim) {
                     if (do_pml_Lo[jdim] &&
                         bbox.smallEnd(jdim) == regular_domain.smallEnd(jdim)) {
-                        bbox.growLo(jdim, ncell[jdim]);
+                        bbox.growLo(jdim, ncell_lo[jdim]);
                     }
                     if (do_pml_Hi[jdim] &&
                         bbox.bigEnd(jdim) == regular_domain.bigEnd(jdim)) {
-                        bbox.growHi(jdim, ncell[jdim]);
+                        bbox.growHi(jdim, ncell_hi[jdim]);
                     }
                 }
                 bl.push_back(bbox);
@@ -964,16 +977,17 @@ PML::MakeBoxArray_single (const amrex::Box& regular_domain, const amrex::BoxArra
 
 BoxArray
 PML::MakeBoxArray_multiple (const amrex::Geometry& geom, const amrex::BoxArray& grid_ba,
-                            const amrex::IntVect& ncell, int do_pml_in_domain,
+                            const amrex::IntVect& ncell_lo, const amrex::IntVect& ncell_hi,
+                            int do_pml_in_domain,
                             const amrex::IntVect& do_pml_Lo, const amrex::IntVect& do_pml_Hi)
 {
     Box domain = geom.Domain();
     for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
         if (do_pml_Lo[idim]){
-            domain.growLo(idim, ncell[idim]);
+            domain.growLo(idim, ncell_lo[idim]);
         }
         if (do_pml_Hi[idim]){
-            domain.growHi(idim, ncell[idim]);
+            domain.growHi(idim, ncell_hi[idim]);
         }
     }
     BoxList bl;
@@ -990,14 +1004,17 @@ PML::MakeBoxArray_multiple (const amrex::Geometry& geom, const amrex::BoxArray&
             for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
                 if (do_pml_Lo[idim] || do_pml_Hi[idim]) {
                     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-                        grid_bx.length(idim) > ncell[idim],
+                        grid_bx.length(idim) > std::max(ncell_lo[idim], ncell_hi[idim]),
                         "Consider using larger amr.blocking_factor with PMLs");
                 }
             }
         }
 
         Box bx = grid_bx;
-        bx.grow(ncell);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            bx.growLo(idim, ncell_lo[idim]);
+            bx.growHi(idim, ncell_hi[idim]);
+        }
         bx &= domain;
 
         Vector<Box> bndryboxes;
@@ -253,6 +253,8 @@ WarpX::DampJPML (int lev, PatchType patch_type)
     if (!do_pml) { return; }
     if (!do_pml_j_damping) { return; }
     if (!pml[lev]) { return; }
+    // The current in the PML is only allocated when particles can enter the PML
+    if (!pml_has_particles) { return; }
 
     WARPX_PROFILE("WarpX::DampJPML()");
 
@@ -31,10 +31,14 @@
 #include <AMReX_Algorithm.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_CoordSys.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FileSystem.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
 #include <AMReX_ParallelContext.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
@@ -44,7 +48,9 @@
 #include <cmath>
 #include <cstdio>
 #include <memory>
+#include <set>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 using namespace amrex::literals;
@@ -95,6 +101,7 @@ void BTDiagnostics::DerivedInitData ()
     m_first_flush_after_restart.resize(m_num_buffers);
     m_snapshot_geometry_defined.resize(m_num_buffers);
     m_field_buffer_multifab_defined.resize(m_num_buffers);
+    m_lab_frame_planes.resize(nmax_lev);
     for (int i = 0; i < m_num_buffers; ++i) {
         m_geom_snapshot[i].resize(nmax_lev);
         m_snapshot_full[i] = 0;
@@ -289,6 +296,11 @@ BTDiagnostics::ReadParameters ()
         m_do_back_transformed_fields = false;
     }
 
+    // openPMD writes each box of the buffers as a chunk of the snapshot, hence the
+    // back-transformed z-slices can stay on the ranks that computed them. The plotfile
+    // buffers are merged in the snapshot assuming a single box per buffer.
+    m_distribute_field_buffers = (m_format == "openpmd");
+
 }
 
 bool
@@ -565,8 +577,9 @@ BTDiagnostics::InitializeFieldFunctors (int lev)
         // is coarsened based on the user-defined m_crse_ratio
         const int nvars = static_cast<int>(m_varnames.size());
         m_all_field_functors[lev][i] = std::make_unique<BackTransformFunctor>(
-                  fields.get(m_cell_centered_data_name, lev), lev,
-                  nvars, m_num_buffers, m_varnames, m_varnames_fields);
+                  &m_lab_frame_planes[lev], lev,
+                  nvars, m_num_buffers, m_varnames, m_varnames_fields,
+                  m_distribute_field_buffers);
     }
 
     // Define all cell-centered functors required to compute cell-centere data
@@ -686,9 +699,9 @@ BTDiagnostics::InitializeFieldFunctorsRZopenPMD (int lev)
     for (int i = 0; i < num_BT_functors; ++i) {
         const int nvars = static_cast<int>(m_varnames.size());
         m_all_field_functors[lev][i] = std::make_unique<BackTransformFunctor>(
-                                       fields.get(m_cell_centered_data_name, lev), lev,
+                                       &m_lab_frame_planes[lev], lev,
                                        nvars, m_num_buffers, m_varnames,
-                                       m_varnames_fields);
+                                       m_varnames_fields, m_distribute_field_buffers);
     }
 
     // Reset field functors for cell-center multifab
@@ -878,9 +891,82 @@ BTDiagnostics::PrepareFieldDataForOutput ()
 
             }
         }
+        // Lorentz-transform once the z-planes used by all the snapshots
+        UpdateLabFramePlanes(lev);
     }
 }
 
+void
+BTDiagnostics::UpdateLabFramePlanes (const int lev)
+{
+    auto & warpx = WarpX::GetInstance();
+    amrex::MultiFab const& cc = *warpx.m_fields.get(m_cell_centered_data_name, lev);
+    amrex::Geometry const& geom = warpx.Geom(lev);
+
+    // Lower index of the two z-planes around the z-slice of each snapshot
+    // back-transformed at this step (see BackTransformFunctor::PrepareFunctorData)
+    std::set<int> slice_indices;
+    for (int i_buffer = 0; i_buffer < m_num_buffers; ++i_buffer) {
+        if (GetZSliceInDomainFlag(i_buffer, lev) && m_snapshot_full[i_buffer] == 0) {
+            slice_indices.insert(
+                BackTransformFunctor::SliceIndexAndWeight(m_current_z_boost[i_buffer], geom).first);
+        }
+    }
+
+    // For each box of the cell-centered data, the z-planes i and i+1 for the slices at
+    // an index i inside the box, where the plane i+1 can be in the guard cells.
+    // Consecutive planes are stored in the same box.
+    amrex::BoxList bl;
+    amrex::Vector<int> pmap;
+    amrex::Vector<int> cc_index;
+    for (int ibox = 0; ibox < static_cast<int>(cc.boxArray().size()); ++ibox) {
+        amrex::Box const& valid_box = cc.boxArray()[ibox];
+        auto add_planes = [&] (int lo, int hi) {
+            amrex::Box planes_box = valid_box;
+            planes_box.setSmall(m_moving_window_dir, lo);
+            planes_box.setBig(m_moving_window_dir, hi);
+            bl.push_back(planes_box);
+            pmap.push_back(cc.DistributionMap()[ibox]);
+            cc_index.push_back(ibox);
+        };
+        int planes_lo = 0;
+        int planes_hi = -1;
+        for (int const i : slice_indices) {
+            if (i < valid_box.smallEnd(m_moving_window_dir) || i > valid_box.bigEnd(m_moving_window_dir)) {
+                continue;
+            }
+            if (planes_hi >= planes_lo && i <= planes_hi + 1) {
+                planes_hi = i + 1;
+            } else {
+                if (planes_hi >= planes_lo) { add_planes(planes_lo, planes_hi); }
+                planes_lo = i;
+                planes_hi = i + 1;
+            }
+        }
+        if (planes_hi >= planes_lo) { add_planes(planes_lo, planes_hi); }
+    }
+
+    if (bl.isEmpty()) {
+        m_lab_frame_planes[lev] = amrex::MultiFab();
+        return;
+    }
+    m_lab_frame_planes[lev] = amrex::MultiFab(amrex::BoxArray(std::move(bl)),
+                                              amrex::DistributionMapping(std::move(pmap)),
+                                              cc.nComp(), 0);
+    amrex::MultiFab& planes = m_lab_frame_planes[lev];
+    for (amrex::MFIter mfi(planes, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        amrex::Array4<amrex::Real const> const& cc_arr = cc.const_array(cc_index[mfi.index()]);
+        amrex::Array4<amrex::Real> const& planes_arr = planes.array(mfi);
+        amrex::ParallelFor(mfi.tilebox(), planes.nComp(),
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+            {
+                planes_arr(i, j, k, n) = cc_arr(i, j, k, n);
+            });
+    }
+    BackTransformFunctor::LorentzTransformZ(planes, m_gamma_boost, m_beta_boost);
+}
+
 
 amrex::Real
 BTDiagnostics::dz_lab (amrex::Real dt, amrex::Real ref_ratio) const
@@ -923,14 +1009,18 @@ BTDiagnostics::DefineFieldBufferMultiFab (const int i_buffer, const int lev)
     m_buffer_box[i_buffer].setSmall( m_moving_window_dir, hi_k_lab - m_buffer_size + 1);
     m_buffer_box[i_buffer].setBig( m_moving_window_dir, hi_k_lab );
     const amrex::BoxArray buffer_ba( m_buffer_box[i_buffer] );
-    // Generate a new distribution map for the back-transformed buffer multifab
-    const amrex::DistributionMapping buffer_dmap(buffer_ba);
-    // Number of guard cells for the output buffer is zero.
-    // Unlike FullDiagnostics, "m_format == sensei" option is not included here.
-    const int ngrow = 0;
-    m_mf_output[i_buffer][lev] = amrex::MultiFab( buffer_ba, buffer_dmap,
-                                              static_cast<int>(m_varnames.size()), ngrow );
-    m_mf_output[i_buffer][lev].setVal(0.);
+    if (!m_distribute_field_buffers) {
+        // Generate a new distribution map for the back-transformed buffer multifab
+        const amrex::DistributionMapping buffer_dmap(buffer_ba);
+        // Number of guard cells for the output buffer is zero.
+        // Unlike FullDiagnostics, "m_format == sensei" option is not included here.
+        const int ngrow = 0;
+        m_mf_output[i_buffer][lev] = amrex::MultiFab( buffer_ba, buffer_dmap,
+                                                  static_cast<int>(m_varnames.size()), ngrow );
+        m_mf_output[i_buffer][lev].setVal(0.);
+    }
+    // Otherwise, m_mf_output is defined from the z-slices stored by the functor
+    // when the buffer is flushed (see BackTransformFunctor::AssembleBufferData)
 
     auto ref_ratio = amrex::IntVect(1);
     if (lev > 0 ) { ref_ratio = WarpX::RefRatio(lev-1); }
@@ -968,7 +1058,8 @@ BTDiagnostics::DefineFieldBufferMultiFab (const int i_buffer, const int lev)
                                                       WarpX::RefRatio(lev-1) );
     }
     m_field_buffer_multifab_defined[i_buffer] = 1;
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE( m_mf_output[i_buffer][lev].boxArray().size() == 1,
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE( m_distribute_field_buffers ||
+        m_mf_output[i_buffer][lev].boxArray().size() == 1,
         "BoxArray size must be 1 for back-transformed diagnostics multifab that stores buffers");
 }
 
@@ -1087,6 +1178,11 @@ BTDiagnostics::Flush (int i_buffer, bool force_flush)
             }
         }
     }
+    if (m_distribute_field_buffers && m_do_back_transformed_fields) {
+        for (int lev = 0; lev < nlev_output; ++lev) {
+            m_all_field_functors[lev][0]->AssembleBufferData(m_mf_output[i_buffer][lev], i_buffer);
+        }
+    }
     m_flush_format->WriteToFile(
         m_varnames, m_mf_output.at(i_buffer), m_geom_output.at(i_buffer), warpx.getistep(),
         labtime,
@@ -1120,6 +1216,13 @@ BTDiagnostics::Flush (int i_buffer, bool force_flush)
         MergeBuffersForPlotfile(i_buffer);
     }
 
+    if (m_distribute_field_buffers) {
+        // The buffer is assembled again at the next flush
+        for (int lev = 0; lev < nlev_output; ++lev) {
+            m_mf_output[i_buffer][lev] = amrex::MultiFab();
+        }
+    }
+
     // Reset the buffer counter to zero after flushing out data stored in the buffer.
     ResetBufferCounter(i_buffer);
     m_field_buffer_multifab_defined[i_buffer] = 0;
@@ -14,6 +14,7 @@
 
 #include <AMReX_Array4.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_Extension.H>
 #include <AMReX_FArrayBox.H>
@@ -24,23 +25,66 @@
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
-#include <AMReX_MultiFabUtil.H>
+#include <AMReX_ParallelDescriptor.H>
 
 #include <cmath>
 #include <map>
 #include <memory>
+#include <utility>
 
 using namespace amrex;
 
+namespace
+{
+    /** Copy the user-requested components of the back-transformed z-slice src, in box tbx,
+     *  to the lab-frame z index k_lab of dst */
+    void
+    CopyUserComponents (amrex::Box const& tbx, amrex::Array4<amrex::Real const> const& src_arr,
+                        amrex::Array4<amrex::Real> const& dst_arr, const int k_lab,
+                        const int ncomp_dst, int const* field_map_ptr)
+    {
+#ifdef WARPX_DIM_RZ
+        const int n_rz_comp = WarpX::ncomps;
+#endif
+        amrex::ParallelFor( tbx, ncomp_dst,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+            {
+                // Field id that corresponds to the nth user-requested component
+                const int icomp = field_map_ptr[n];
+#if defined(WARPX_DIM_3D)
+                dst_arr(i, j, k_lab, n) = src_arr(i, j, k, icomp);
+#elif defined(WARPX_DIM_XZ)
+                dst_arr(i, k_lab, k, n) = src_arr(i, j, k, icomp);
+#elif defined(WARPX_DIM_RZ)
+                // rzcomp below gives the component id, 0 to (n_rz_comp-1) for a given field
+                const int rzcomp = n % n_rz_comp;
+                // Accessing the correct rz component from the cell-centered multifab
+                // that has back-transformed fields and storing it for the appropriate user-requested field, icomp
+                // For example, for 2 rz modes, we have three components (n_rz_comp=3) for each field
+                // If n = 4 gives icomp = 1 (for Et) obtained from field_map_ptr,
+                //           rzcomp = 4 - int(floor(4/3))*3 = 4 - 3 = 1
+                // Thus we are accessing real component of mode 1 of Et (note that modes go from 0 to 1)
+                // Since the fields are stored contiguously in src_arr, icomp*n_rz_comp + rz_comp accesses
+                // real part of mode 1 for Et (1*3+1) = 4
+                dst_arr(i, k_lab, k, n) = src_arr(i, j, k, icomp*n_rz_comp+rzcomp);
+#else
+                dst_arr(k_lab, j, k, n) = src_arr(i, j, k, icomp);
+#endif
+            } );
+    }
+}
+
 BackTransformFunctor::BackTransformFunctor (amrex::MultiFab const * mf_src, int lev,
                                             const int ncomp, const int num_buffers,
                                             amrex::Vector< std::string > varnames,
                                             amrex::Vector< std::string > varnames_fields,
+                                            const bool distribute_buffers,
                                             const amrex::IntVect crse_ratio
                                             ):
     ComputeDiagFunctor(ncomp, crse_ratio),
     m_mf_src{mf_src}, m_lev{lev}, m_num_buffers{num_buffers},
-    m_varnames{std::move(varnames)}, m_varnames_fields{std::move(varnames_fields)}
+    m_varnames{std::move(varnames)}, m_varnames_fields{std::move(varnames_fields)},
+    m_distribute_buffers{distribute_buffers}
 {
     InitData();
 }
@@ -53,36 +97,40 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
     if ( m_perform_backtransform[i_buffer] == 1) {
         auto& warpx = WarpX::GetInstance();
         auto geom = warpx.Geom(m_lev);
-        const amrex::Real gamma_boost = WarpX::gamma_boost;
         const int moving_window_dir = WarpX::moving_window_dir;
-        const amrex::Real beta_boost = std::sqrt( 1._rt - 1._rt/( gamma_boost * gamma_boost) );
-        const bool interpolate = true;
         std::unique_ptr< amrex::MultiFab > slice = nullptr;
-        const int scomp = 0;
 
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_mf_src != nullptr, "m_mf_src can't be a nullptr.");
         AMREX_ASSUME(m_mf_src != nullptr);
 
-        // Generate slice of the cell-centered multifab containing boosted-frame field-data
-        // at current z-boost location for the ith buffer
-        slice = amrex::get_slice_data(
-            moving_window_dir,
-            m_current_z_boost[i_buffer],
-            *m_mf_src,
-            geom,
-            scomp,
-            m_mf_src->nComp(),
-            interpolate);
+        // Interpolate the lab-frame field-data at the current z-boost location for
+        // the ith buffer, from the Lorentz-transformed z-planes of m_mf_src
+        const auto [i_boost, weight] = SliceIndexAndWeight(m_current_z_boost[i_buffer], geom);
+        slice = InterpolateSlice(i_boost, weight);
+        if (slice == nullptr) { return; }
 
+        const int k_lab = m_k_index_zlab[i_buffer];
+        const int ncomp_dst = static_cast<int>(m_map_varnames.size());
+#ifdef AMREX_USE_GPU
+        Gpu::DeviceVector<int> d_map_varnames(m_map_varnames.size());
+        Gpu::copyAsync(Gpu::hostToDevice,
+                       m_map_varnames.begin(), m_map_varnames.end(),
+                       d_map_varnames.begin());
+        Gpu::synchronize();
+        int const* field_map_ptr = d_map_varnames.dataPtr();
+#else
+        int const* field_map_ptr = m_map_varnames.dataPtr();
+#endif
 
-        // Perform in-place Lorentz-transform of all the fields stored in the slice.
-        LorentzTransformZ( *slice, gamma_boost, beta_boost);
+        if (m_distribute_buffers) {
+            // The lab-frame data stays on the ranks that own the slice (see AssembleBufferData)
+            StoreLabSlice(*slice, i_buffer, k_lab, field_map_ptr);
+            // The kernels use field_map_ptr
+            Gpu::streamSynchronize();
+            return;
+        }
 
         // Create a 2D box for the slice in the boosted frame
-        const amrex::Real dx = geom.CellSize(moving_window_dir);
-        // index corresponding to z_boost location in the boost-frame
-        const int i_boost = static_cast<int> ( ( m_current_z_boost[i_buffer]
-                                            - geom.ProbLo(moving_window_dir) ) / dx );
         // z-Slice at i_boost with x,y indices same as buffer_box
         amrex::Box slice_box = m_buffer_box[i_buffer];
         slice_box.setSmall(moving_window_dir, i_boost);
@@ -105,52 +153,11 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
                                                     WarpX::do_single_precision_comms);
         // Now we will cherry pick only the user-defined fields from
         // tmp_slice_ptr to dst_mf
-        const int k_lab = m_k_index_zlab[i_buffer];
-        const int ncomp_dst = mf_dst.nComp();
         amrex::MultiFab& tmp = *tmp_slice_ptr;
-#ifdef AMREX_USE_GPU
-        Gpu::DeviceVector<int> d_map_varnames(m_map_varnames.size());
-        Gpu::copyAsync(Gpu::hostToDevice,
-                       m_map_varnames.begin(), m_map_varnames.end(),
-                       d_map_varnames.begin());
-        Gpu::synchronize();
-        int const* field_map_ptr = d_map_varnames.dataPtr();
-#else
-        int const* field_map_ptr = m_map_varnames.dataPtr();
-#endif
         for (amrex::MFIter mfi(tmp, TilingIfNotGPU()); mfi.isValid(); ++mfi)
         {
-            const Box& tbx = mfi.tilebox();
-            const amrex::Array4<amrex::Real> src_arr = tmp[mfi].array();
-            const amrex::Array4<amrex::Real> dst_arr = mf_dst[mfi].array();
-#ifdef WARPX_DIM_RZ
-            const int n_rz_comp = WarpX::ncomps;
-#endif
-            amrex::ParallelFor( tbx, ncomp_dst,
-                [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
-                {
-                    // Field id that corresponds to the nth user-requested component
-                    const int icomp = field_map_ptr[n];
-#if defined(WARPX_DIM_3D)
-                    dst_arr(i, j, k_lab, n) = src_arr(i, j, k, icomp);
-#elif defined(WARPX_DIM_XZ)
-                    dst_arr(i, k_lab, k, n) = src_arr(i, j, k, icomp);
-#elif defined(WARPX_DIM_RZ)
-                    // rzcomp below gives the component id, 0 to (n_rz_comp-1) for a given field
-                    const int rzcomp = n % n_rz_comp;
-                    // Accessing the correct rz component from the cell-centered multifab
-                    // that has back-transformed fields and storing it for the appropriate user-requested field, icomp
-                    // For example, for 2 rz modes, we have three components (n_rz_comp=3) for each field
-                    // If n = 4 gives icomp = 1 (for Et) obtained from field_map_ptr,
-                    //           rzcomp = 4 - int(floor(4/3))*3 = 4 - 3 = 1
-                    // Thus we are accessing real component of mode 1 of Et (note that modes go from 0 to 1)
-                    // Since the fields are stored contiguously in src_arr, icomp*n_rz_comp + rz_comp accesses
-                    // real part of mode 1 for Et (1*3+1) = 4
-                    dst_arr(i, k_lab, k, n) = src_arr(i, j, k, icomp*n_rz_comp+rzcomp);
-#else
-                    dst_arr(k_lab, j, k, n) = src_arr(i, j, k, icomp);
-#endif
-                } );
+            CopyUserComponents(mfi.tilebox(), tmp.const_array(mfi), mf_dst.array(mfi),
+                               k_lab, ncomp_dst, field_map_ptr);
         }
 
         // Reset the temporary MultiFabs generated
@@ -160,6 +167,208 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
 
 }
 
+std::pair<int, amrex::Real>
+BackTransformFunctor::SliceIndexAndWeight (const amrex::Real z_boost, amrex::Geometry const& geom)
+{
+    const int moving_window_dir = WarpX::moving_window_dir;
+    // position in units of the cell size, relative to the first cell center
+    const amrex::Real z_index = ( z_boost - geom.ProbLo(moving_window_dir) )
+                                * geom.InvCellSize(moving_window_dir) - 0.5_rt;
+    const auto i_boost = static_cast<int>( std::floor(z_index) );
+    return {i_boost, z_index - static_cast<amrex::Real>(i_boost)};
+}
+
+std::unique_ptr<amrex::MultiFab>
+BackTransformFunctor::InterpolateSlice (const int i_boost, const amrex::Real weight) const
+{
+    const int moving_window_dir = WarpX::moving_window_dir;
+    amrex::MultiFab const& planes = *m_mf_src;
+
+    // In each column, the box containing both z-planes i_boost and i_boost+1 is unique
+    amrex::BoxList bl;
+    amrex::Vector<int> pmap;
+    amrex::Vector<int> planes_index;
+    for (int ibox = 0; ibox < static_cast<int>(planes.boxArray().size()); ++ibox) {
+        amrex::Box const& box = planes.boxArray()[ibox];
+        if (box.smallEnd(moving_window_dir) <= i_boost && box.bigEnd(moving_window_dir) >= i_boost+1) {
+            amrex::Box slice_box = box;
+            slice_box.setSmall(moving_window_dir, i_boost);
+            slice_box.setBig(moving_window_dir, i_boost);
+            bl.push_back(slice_box);
+            pmap.push_back(planes.DistributionMap()[ibox]);
+            planes_index.push_back(ibox);
+        }
+    }
+    if (bl.isEmpty()) { return nullptr; }
+
+    auto slice = std::make_unique<amrex::MultiFab>(
+        amrex::BoxArray(std::move(bl)), amrex::DistributionMapping(std::move(pmap)), planes.nComp(), 0);
+
+    const int di = (moving_window_dir == 0) ? 1 : 0;
+    const int dj = (moving_window_dir == 1) ? 1 : 0;
+    const int dk = (moving_window_dir == 2) ? 1 : 0;
+    for (amrex::MFIter mfi(*slice, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        amrex::Array4<amrex::Real const> const& planes_arr = planes.const_array(planes_index[mfi.index()]);
+        amrex::Array4<amrex::Real> const& slice_arr = slice->array(mfi);
+        amrex::ParallelFor( mfi.tilebox(), slice->nComp(),
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+            {
+                slice_arr(i, j, k, n) = (1._rt - weight) * planes_arr(i, j, k, n)
+                                      + weight * planes_arr(i+di, j+dj, k+dk, n);
+            } );
+    }
+    return slice;
+}
+
+void
+BackTransformFunctor::StoreLabSlice (amrex::MultiFab const& slice, const int i_buffer,
+                                     const int k_lab, int const* field_map_ptr) const
+{
+    const int moving_window_dir = WarpX::moving_window_dir;
+    const int ncomp_dst = static_cast<int>(m_map_varnames.size());
+
+    // Parts of the boxes of the slice inside the buffer, moved to the lab-frame
+    // z index. The BoxArray of the slice is known on all the ranks, hence so is
+    // the layout of the lab-frame slice.
+    amrex::BoxList bl;
+    amrex::Vector<int> pmap;
+    amrex::Vector<int> slice_index;
+    amrex::BoxArray const& slice_ba = slice.boxArray();
+    for (int ibox = 0; ibox < static_cast<int>(slice_ba.size()); ++ibox) {
+        amrex::Box box = slice_ba[ibox];
+        amrex::Box buffer_columns = m_buffer_box[i_buffer];
+        buffer_columns.setSmall(moving_window_dir, box.smallEnd(moving_window_dir));
+        buffer_columns.setBig(moving_window_dir, box.bigEnd(moving_window_dir));
+        box &= buffer_columns;
+        if (box.ok()) {
+            box.setSmall(moving_window_dir, k_lab);
+            box.setBig(moving_window_dir, k_lab);
+            bl.push_back(box);
+            pmap.push_back(slice.DistributionMap()[ibox]);
+            slice_index.push_back(ibox);
+        }
+    }
+    if (bl.isEmpty()) { return; }
+
+    LabSlice lab_slice;
+    lab_slice.k_lab = k_lab;
+    lab_slice.data = std::make_unique<amrex::MultiFab>(
+        amrex::BoxArray(std::move(bl)), amrex::DistributionMapping(std::move(pmap)), ncomp_dst, 0);
+
+    for (amrex::MFIter mfi(*lab_slice.data); mfi.isValid(); ++mfi)
+    {
+        const int isrc = slice_index[mfi.index()];
+        // Box of the slice in the boosted frame
+        amrex::Box tbx = mfi.validbox();
+        tbx.setRange(moving_window_dir, slice_ba[isrc].smallEnd(moving_window_dir),
+                     slice_ba[isrc].length(moving_window_dir));
+        CopyUserComponents(tbx, slice.const_array(isrc), lab_slice.data->array(mfi),
+                           k_lab, ncomp_dst, field_map_ptr);
+    }
+    m_lab_slices[i_buffer].push_back(std::move(lab_slice));
+}
+
+void
+BackTransformFunctor::AssembleBufferData (amrex::MultiFab& mf_dst, const int i_buffer)
+{
+    if (!m_distribute_buffers) { return; }
+
+    const int moving_window_dir = WarpX::moving_window_dir;
+    auto& lab_slices = m_lab_slices[i_buffer];
+    amrex::Box const& buffer_box = m_buffer_box[i_buffer];
+
+    // Last slice stored at each z index of the buffer
+    std::map<int, int> slice_at_k;
+    for (int islice = 0; islice < static_cast<int>(lab_slices.size()); ++islice) {
+        const int k = lab_slices[islice].k_lab;
+        if (k >= buffer_box.smallEnd(moving_window_dir) && k <= buffer_box.bigEnd(moving_window_dir)) {
+            slice_at_k[k] = islice;
+        }
+    }
+
+    // Boxes of the buffer: the boxes of consecutive slices with the same transverse
+    // extent and owner are merged, and the z indices without slice are filled with zeros.
+    struct BufferBox {
+        amrex::Box box;
+        int rank;
+        //! index of the slice and of the box in the slice, for the slices in the box
+        amrex::Vector<std::pair<int, int>> slice_boxes;
+    };
+    amrex::Vector<BufferBox> buffer_boxes;
+    amrex::Vector<int> open_boxes;
+    int num_zero_boxes = 0;
+    int k_prev = buffer_box.smallEnd(moving_window_dir) - 1;
+    for (auto const& [k, islice] : slice_at_k) {
+        if (k > k_prev + 1) {
+            amrex::Box zero_box = buffer_box;
+            zero_box.setSmall(moving_window_dir, k_prev + 1);
+            zero_box.setBig(moving_window_dir, k - 1);
+            buffer_boxes.push_back({zero_box, num_zero_boxes++ % amrex::ParallelDescriptor::NProcs(), {}});
+            open_boxes.clear();
+        }
+        amrex::MultiFab const& slice = *lab_slices[islice].data;
+        amrex::Vector<int> new_open_boxes;
+        for (int ibox = 0; ibox < static_cast<int>(slice.boxArray().size()); ++ibox) {
+            amrex::Box const& box = slice.boxArray()[ibox];
+            const int rank = slice.DistributionMap()[ibox];
+            int ibuffer_box = -1;
+            for (int const iopen : open_boxes) {
+                amrex::Box columns = buffer_boxes[iopen].box;
+                columns.setSmall(moving_window_dir, k);
+                columns.setBig(moving_window_dir, k);
+                if (columns == box && buffer_boxes[iopen].rank == rank) {
+                    ibuffer_box = iopen;
+                    break;
+                }
+            }
+            if (ibuffer_box >= 0) {
+                buffer_boxes[ibuffer_box].box.setBig(moving_window_dir, k);
+            } else {
+                ibuffer_box = static_cast<int>(buffer_boxes.size());
+                buffer_boxes.push_back({box, rank, {}});
+            }
+            buffer_boxes[ibuffer_box].slice_boxes.emplace_back(islice, ibox);
+            new_open_boxes.push_back(ibuffer_box);
+        }
+        open_boxes = std::move(new_open_boxes);
+        k_prev = k;
+    }
+    if (k_prev < buffer_box.bigEnd(moving_window_dir)) {
+        amrex::Box zero_box = buffer_box;
+        zero_box.setSmall(moving_window_dir, k_prev + 1);
+        buffer_boxes.push_back({zero_box, num_zero_boxes % amrex::ParallelDescriptor::NProcs(), {}});
+    }
+
+    amrex::BoxList bl;
+    amrex::Vector<int> pmap;
+    for (auto const& buffer_box_data : buffer_boxes) {
+        bl.push_back(buffer_box_data.box);
+        pmap.push_back(buffer_box_data.rank);
+    }
+    mf_dst = amrex::MultiFab(amrex::BoxArray(std::move(bl)), amrex::DistributionMapping(std::move(pmap)),
+                             static_cast<int>(m_map_varnames.size()), 0);
+    mf_dst.setVal(0.);
+
+    // Local copies, since each slice is owned by the rank of its buffer box
+    for (amrex::MFIter mfi(mf_dst); mfi.isValid(); ++mfi)
+    {
+        amrex::Array4<amrex::Real> const& dst_arr = mf_dst.array(mfi);
+        for (auto const& [islice, ibox] : buffer_boxes[mfi.index()].slice_boxes) {
+            amrex::MultiFab const& slice = *lab_slices[islice].data;
+            amrex::Array4<amrex::Real const> const& src_arr = slice.const_array(ibox);
+            amrex::ParallelFor(slice.boxArray()[ibox], slice.nComp(),
+                [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                {
+                    dst_arr(i, j, k, n) = src_arr(i, j, k, n);
+                });
+        }
+    }
+    Gpu::streamSynchronize();
+
+    lab_slices.clear();
+}
+
 void
 BackTransformFunctor::PrepareFunctorData (int i_buffer,
                           bool z_slice_in_domain, amrex::Real current_z_boost,
@@ -181,6 +390,7 @@ BackTransformFunctor::InitData ()
     m_current_z_boost.resize( m_num_buffers );
     m_perform_backtransform.resize( m_num_buffers );
     m_k_index_zlab.resize( m_num_buffers );
+    m_lab_slices.resize( m_num_buffers );
     m_map_varnames.resize( m_varnames.size() );
 
 #ifdef WARPX_DIM_RZ
@@ -225,7 +435,7 @@ BackTransformFunctor::InitData ()
 
 void
 BackTransformFunctor::LorentzTransformZ (amrex::MultiFab& data, amrex::Real gamma_boost,
-                                         amrex::Real beta_boost) const
+                                         amrex::Real beta_boost)
 {
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
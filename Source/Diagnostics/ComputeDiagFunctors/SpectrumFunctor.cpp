@@ -0,0 +1,104 @@
+#include "SpectrumFunctor.H"
+
+#include "Utils/TextMsg.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Array.H>
+#include <AMReX_Array4.H>
+#include <AMReX_BaseFab.H>
+#include <AMReX_Box.H>
+#include <AMReX_Extension.H>
+#include <AMReX_FabArray.H>
+#include <AMReX_GpuComplex.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_Math.H>
+#include <AMReX_MultiFab.H>
+
+#include <cmath>
+#include <utility>
+
+namespace
+{
+    /** Periodic Hann window at index n of an axis of len cells (one if len is one) */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    amrex::Real hann_window (int n, int len)
+    {
+        using namespace amrex::literals;
+        if (len <= 1) { return 1._rt; }
+        amrex::Real const s = std::sin(amrex::Math::pi<amrex::Real>() * n / len);
+        return s*s;
+    }
+}
+
+SpectrumFunctor::SpectrumFunctor (amrex::MultiFab const * mf_src, int lev,
+                                  amrex::IntVect crse_ratio,
+                                  std::shared_ptr<R2C> r2c,
+                                  SpectrumWindow window)
+    : ComputeDiagFunctor(1, crse_ratio), m_mf_src(mf_src), m_lev(lev),
+      m_r2c(std::move(r2c)), m_window(window)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(crse_ratio == amrex::IntVect(1),
+        "SpectrumFunctor: the spectrum can only be computed without coarsening");
+}
+
+void
+SpectrumFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp, const int /*i_buffer*/) const
+{
+    using namespace amrex::literals;
+    auto& warpx = WarpX::GetInstance();
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_mf_src != nullptr, "m_mf_src can't be a nullptr.");
+    AMREX_ASSUME(m_mf_src != nullptr);
+
+    // Cell-centered copy of the field, on the grids of the simulation
+    amrex::MultiFab mf_cc(amrex::convert(m_mf_src->boxArray(), amrex::IntVect::TheCellVector()),
+                          m_mf_src->DistributionMap(), 1, 0);
+    InterpolateMFForDiag(mf_cc, *m_mf_src, 0, m_mf_src->DistributionMap(), false);
+
+    amrex::Box const domain = warpx.Geom(m_lev).Domain();
+    if (m_window == SpectrumWindow::hann)
+    {
+        // the window is one along the dimensions that are not simulated (length 1)
+        auto const dlo = amrex::lbound(domain);
+        auto const dlen = amrex::length(domain);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (amrex::MFIter mfi(mf_cc, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            auto const& arr = mf_cc.array(mfi);
+            amrex::ParallelFor(mfi.tilebox(),
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                    arr(i,j,k) *= hann_window(i - dlo.x, dlen.x) * hann_window(j - dlo.y, dlen.y)
+                                * hann_window(k - dlo.z, dlen.z);
+                });
+        }
+    }
+
+    // Distributed FFT over the whole domain
+    auto const [spectral_ba, spectral_dm] = m_r2c->getSpectralDataLayout();
+    amrex::FabArray<amrex::BaseFab<amrex::GpuComplex<amrex::Real>>> spectral_field(
+        spectral_ba, spectral_dm, 1, 0);
+    m_r2c->forward(mf_cc, spectral_field);
+
+    // Power spectrum, normalized such that it does not depend on the number of cells
+    amrex::Real const ncells = domain.d_numPts();
+    amrex::Real const norm = 1._rt / (ncells*ncells);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(spectral_field, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        auto const& fk = spectral_field.const_array(mfi);
+        auto const& dst = mf_dst.array(mfi);
+        amrex::ParallelFor(mfi.tilebox(),
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                auto const c = fk(i,j,k);
+                dst(i,j,k,dcomp) = (c.real()*c.real() + c.imag()*c.imag()) * norm;
+            });
+    }
+}
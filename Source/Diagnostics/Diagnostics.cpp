@@ -17,6 +17,7 @@
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
@@ -27,6 +28,8 @@
 #include <AMReX_BLassert.H>
 #include <AMReX_Config.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
@@ -34,6 +37,7 @@
 #include <AMReX_Vector.H>
 
 #include <algorithm>
+#include <cmath>
 #include <string>
 
 using namespace amrex::literals;
@@ -540,8 +544,9 @@ Diagnostics::InitBaseData ()
         m_mf_output[i].resize( nmax_lev );
     }
 
-    // allocate vector of buffers and vector of levels for each buffer for summation multifab for TimeAveragedDiagnostics
-    if (m_diag_type == DiagTypes::TimeAveraged) {
+    // allocate vector of buffers and vector of levels for each buffer for summation multifab
+    // for TimeAveragedDiagnostics and for the running Fourier transforms of FrequencyDomain diagnostics
+    if (m_diag_type == DiagTypes::TimeAveraged || m_diag_type == DiagTypes::FrequencyDomain) {
         m_sum_mf_output.resize(m_num_buffers);
         for (int i = 0; i < m_num_buffers; ++i) {
             m_sum_mf_output[i].resize( nmax_lev );
@@ -558,6 +563,39 @@ Diagnostics::InitBaseData ()
     m_output_species.resize(m_num_buffers);
 }
 
+namespace
+{
+    /** Add the fields of mf to the running discrete Fourier transforms stored in dft_mf.
+     *
+     * \param[in,out] dft_mf real and imaginary parts of the transforms: for the field n and
+     *                the frequency ifreq, the components 2*(n*nfreq+ifreq) and 2*(n*nfreq+ifreq)+1
+     * \param[in] mf fields at the current time
+     * \param[in] weights cos(2 pi f t) dt and sin(2 pi f t) dt for each frequency (size 2*nfreq)
+     */
+    void AccumulateDFT (amrex::MultiFab& dft_mf, amrex::MultiFab const& mf,
+                        amrex::Gpu::DeviceVector<amrex::Real> const& weights)
+    {
+        auto const nfreq = static_cast<int>(weights.size()/2);
+        amrex::Real const* const AMREX_RESTRICT w = weights.dataPtr();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (amrex::MFIter mfi(mf, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            amrex::Array4<amrex::Real const> const& f = mf.const_array(mfi);
+            amrex::Array4<amrex::Real> const& dft = dft_mf.array(mfi);
+            amrex::ParallelFor(mfi.tilebox(), mf.nComp(),
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
+                    amrex::Real const fval = f(i,j,k,n);
+                    for (int ifreq = 0; ifreq < nfreq; ++ifreq) {
+                        int const c = 2*(n*nfreq + ifreq);
+                        dft(i,j,k,c) += fval*w[2*ifreq];
+                        dft(i,j,k,c+1) -= fval*w[2*ifreq+1];
+                    }
+                });
+        }
+    }
+}
+
 void
 Diagnostics::ComputeAndPack ()
 {
@@ -571,6 +609,31 @@ Diagnostics::ComputeAndPack ()
 
     auto & warpx = WarpX::GetInstance();
 
+    // For FrequencyDomain diagnostics, the fields of each step are added once to the
+    // running Fourier transforms, with the weights cos(2 pi f t) dt and sin(2 pi f t) dt.
+    // The phases are computed on the host in double precision.
+    bool const accumulate_dft = (m_diag_type == DiagTypes::FrequencyDomain)
+        && (warpx.getistep(0) >= m_dft_start_step) && (warpx.getistep(0) != m_dft_last_step);
+    amrex::Gpu::DeviceVector<amrex::Real> dft_weights;
+    if (accumulate_dft) {
+        m_dft_last_step = warpx.getistep(0);
+        auto const nfreq = static_cast<int>(m_dft_frequencies.size());
+        auto const t = static_cast<double>(warpx.gett_new(0));
+        auto const dt = static_cast<double>(warpx.getdt(0));
+        amrex::Vector<amrex::Real> h_weights(2*nfreq);
+        for (int ifreq = 0; ifreq < nfreq; ++ifreq) {
+            // Keep only the fractional part of f t, to avoid losing precision at late times
+            double const ft = static_cast<double>(m_dft_frequencies[ifreq])*t;
+            double const phase = 2.*MathConst::pi*(ft - std::floor(ft));
+            h_weights[2*ifreq] = static_cast<amrex::Real>(std::cos(phase)*dt);
+            h_weights[2*ifreq+1] = static_cast<amrex::Real>(std::sin(phase)*dt);
+        }
+        dft_weights.resize(h_weights.size());
+        amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice,
+                              h_weights.begin(), h_weights.end(), dft_weights.begin());
+        amrex::Gpu::streamSynchronize();
+    }
+
     // compute the necessary fields and store result in m_mf_output.
     for (int i_buffer = 0; i_buffer < m_num_buffers; ++i_buffer) {
         for(int lev=0; lev<nlev_output; lev++){
@@ -596,6 +659,10 @@ Diagnostics::ComputeAndPack ()
                         0, 0, m_mf_output[i_buffer][lev].nComp(), m_mf_output[i_buffer][lev].nGrowVect());
             }
 
+            if (accumulate_dft) {
+                AccumulateDFT(m_sum_mf_output[i_buffer][lev], m_mf_output[i_buffer][lev], dft_weights);
+            }
+
             // needed for contour plots of rho, i.e. ascent/sensei
             if (m_format == "sensei" || m_format == "ascent") {
                 ablastr::utils::communication::FillBoundary(m_mf_output[i_buffer][lev], WarpX::do_single_precision_comms,
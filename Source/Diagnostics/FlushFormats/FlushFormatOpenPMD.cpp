@@ -1,5 +1,6 @@
 #include "FlushFormatOpenPMD.H"
 
+#include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "Diagnostics/OpenPMDHelpFunction.H"
@@ -104,13 +105,86 @@ FlushFormatOpenPMD::FlushFormatOpenPMD (const std::string& diag_name)
         engine_parameters.insert({k, v});
     }
 
+    // Asynchronous writes: the data is copied into the buffers of ADIOS2 when the
+    // diagnostic is flushed, and written to disk by ADIOS2 in the background
+    bool async_write = false;
+    pp_diag_name.query("openpmd_async_write", async_write);
+    if (async_write) {
+        if (openpmd_backend != "bp") {
+            ablastr::warn_manager::WMRecordWarning("Diagnostics",
+                diag_name + ".openpmd_async_write is only supported with the ADIOS2 (bp) backend and is ignored.");
+            async_write = false;
+        } else {
+            if (engine_type.empty()) { engine_type = "bp5"; }
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(engine_type == "bp5",
+                diag_name + ".openpmd_async_write requires the ADIOS2 bp5 engine");
+            // keep the value set by the user, if any
+            engine_parameters.insert({"AsyncWrite", "Guided"});
+            if (encoding == openPMD::IterationEncoding::fileBased) {
+                ablastr::warn_manager::WMRecordWarning("Diagnostics",
+                    diag_name + ".openpmd_async_write: with file-based encoding, each file is closed"
+                    " (and thus fully written) at the end of its step. Use group- or variable-based"
+                    " encoding to overlap the writes with the simulation.");
+            }
+        }
+    }
+
+    // ADIOS2 lossy operator applied to the fields with an error bound
+    std::string lossy_operator_type;
+    pp_diag_name.query("adios2_lossy_operator.type", lossy_operator_type);
+    std::map< std::string, FieldErrorBound > field_error_bounds;
+    if (!lossy_operator_type.empty()) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            lossy_operator_type == "zfp" || lossy_operator_type == "sz" || lossy_operator_type == "mgard",
+            diag_name + ".adios2_lossy_operator.type must be zfp, sz or mgard");
+        const ParmParse ppl;
+        for (bool const is_relative : {false, true}) {
+            std::string const bound_prefix = diag_name + ".adios2_lossy_operator."
+                + (is_relative ? "rel_error" : "abs_error");
+            auto const bound_prefix_len = bound_prefix.size() + 1;
+            for (std::string k : amrex::ParmParse::getEntries(bound_prefix)) {
+                FieldErrorBound bound;
+                bound.is_relative = is_relative;
+                utils::parser::getWithParser(ppl, k.c_str(), bound.value);
+                k.erase(0, bound_prefix_len);
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(field_error_bounds.count(k) == 0,
+                    diag_name + ".adios2_lossy_operator: both an absolute and a relative error bound"
+                    " are set for field " + k);
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(bound.value > 0,
+                    diag_name + ".adios2_lossy_operator: the error bound of field " + k + " must be positive");
+                field_error_bounds.insert({k, bound});
+            }
+        }
+        if (openpmd_backend != "bp") {
+            ablastr::warn_manager::WMRecordWarning("Diagnostics",
+                diag_name + ".adios2_lossy_operator is only supported with the ADIOS2 (bp) backend and is ignored.");
+            lossy_operator_type.clear();
+            field_error_bounds.clear();
+        } else if (diag_type_str == "BackTransformed") {
+            // the lab-frame snapshots are written buffer by buffer, hence the maximum
+            // of a field is not known when its dataset is defined
+            for (auto it = field_error_bounds.begin(); it != field_error_bounds.end();) {
+                if (it->second.is_relative) {
+                    ablastr::warn_manager::WMRecordWarning("Diagnostics",
+                        diag_name + ".adios2_lossy_operator.rel_error." + it->first +
+                        " is not supported for back-transformed diagnostics and is ignored.");
+                    it = field_error_bounds.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+
     auto & warpx = WarpX::GetInstance();
     m_OpenPMDPlotWriter = std::make_unique<WarpXOpenPMDPlot>(
         encoding, openpmd_backend,
         operator_type, operator_parameters,
         engine_type, engine_parameters,
         warpx.getPMLdirections(),
-        warpx.GetAuthors()
+        warpx.GetAuthors(),
+        async_write,
+        lossy_operator_type, field_error_bounds
     );
 }
 
@@ -16,6 +16,7 @@
 #include "FlushFormats/FlushFormat.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Utils/Algorithms/IsIn.H"
+#include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "WarpX.H"
@@ -207,6 +208,15 @@ FullDiagnostics::ReadParameters ()
         }
     }
 
+    if (m_diag_type == DiagTypes::FrequencyDomain) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_format != "checkpoint",
+            "FrequencyDomain diagnostics (encountered in: " + m_diag_name
+            + ") do not support the checkpoint format");
+        utils::parser::getArrWithParser(pp_diag_name, "dft_frequencies", m_dft_frequencies);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_dft_frequencies.empty(),
+            m_diag_name + ".dft_frequencies must contain at least one frequency");
+        pp_diag_name.query("dft_start_step", m_dft_start_step);
+    }
 
 #ifdef WARPX_DIM_RZ
     pp_diag_name.query("dump_rz_modes", m_dump_rz_modes);
@@ -271,6 +281,14 @@ FullDiagnostics::Flush ( int i_buffer, bool /* force_flush */ )
                 }
             }
         }
+    } else if (m_diag_type == DiagTypes::FrequencyDomain) {
+        // The running Fourier transforms are written as they are, and keep accumulating
+        m_flush_format->WriteToFile(
+            m_dft_varnames, m_sum_mf_output.at(i_buffer), m_geom_output.at(i_buffer), warpx.getistep(),
+            warpx.gett_new(0),
+            m_output_species.at(i_buffer), nlev_output, m_file_prefix,
+            m_file_min_digits, m_plot_raw_fields, m_plot_raw_fields_guards,
+            m_verbose);
     } else {
         if (m_diag_type == DiagTypes::TimeAveraged && step == 0) {
             // For both dynamic_start and fixed_start at step 0 we prepare an instantaneous output
@@ -357,9 +375,11 @@ FullDiagnostics::DoComputeAndPack (int step, bool force_flush)
             }
         }
     }
+    // The running Fourier transforms are updated at every step after the start step
+    const bool in_dft_period = (m_diag_type == DiagTypes::FrequencyDomain) && (step+1 >= m_dft_start_step);
     // Data must be computed and packed for full diagnostics
     // whenever the data needs to be flushed.
-    return (force_flush || m_intervals.contains(step+1) || in_averaging_period);
+    return (force_flush || m_intervals.contains(step+1) || in_averaging_period || in_dft_period);
 
 }
 
@@ -773,6 +793,22 @@ FullDiagnostics::InitializeBufferData (int i_buffer, int lev, bool restart ) {
         m_sum_mf_output[i_buffer][lev].setVal(0.);
     }
 
+    if (m_diag_type == DiagTypes::FrequencyDomain) {
+        // Allocate MultiFab for the real and imaginary parts of the running Fourier transforms
+        // of each field at each frequency, and name its components accordingly.
+        auto const nfreq = static_cast<int>(m_dft_frequencies.size());
+        m_sum_mf_output[i_buffer][lev] = amrex::MultiFab(ba, dmap, 2*nfreq*ncomp, ngrow);
+        // Initialize to zero because we add data.
+        m_sum_mf_output[i_buffer][lev].setVal(0.);
+        m_dft_varnames.clear();
+        for (auto const& varname : m_varnames) {
+            for (int ifreq = 0; ifreq < nfreq; ++ifreq) {
+                m_dft_varnames.push_back(varname + "_dft" + std::to_string(ifreq) + "_real");
+                m_dft_varnames.push_back(varname + "_dft" + std::to_string(ifreq) + "_imag");
+            }
+        }
+    }
+
     if (lev == 0) {
         // The extent of the domain covered by the diag multifab, m_mf_output
         //default non-periodic geometry for diags
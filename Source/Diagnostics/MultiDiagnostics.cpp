@@ -21,7 +21,8 @@ MultiDiagnostics::MultiDiagnostics ()
      */
     alldiags.resize( ndiags );
     for (int i=0; i<ndiags; i++){
-        if ( diags_types[i] == DiagTypes::Full || diags_types[i] == DiagTypes::TimeAveraged ){
+        if ( diags_types[i] == DiagTypes::Full || diags_types[i] == DiagTypes::TimeAveraged ||
+             diags_types[i] == DiagTypes::FrequencyDomain ){
             alldiags[i] = std::make_unique<FullDiagnostics>(i, diags_names[i], diags_types[i]);
         } else if ( diags_types[i] == DiagTypes::BackTransformed ){
             alldiags[i] = std::make_unique<BTDiagnostics>(i, diags_names[i], diags_types[i]);
@@ -68,10 +69,12 @@ MultiDiagnostics::ReadParameters ()
         std::string diag_type_str;
         pp_diag_name.get("diag_type", diag_type_str);
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-            diag_type_str == "Full" || diag_type_str == "TimeAveraged" || diag_type_str == "BackTransformed" || diag_type_str == "BoundaryScraping",
-            "<diag>.diag_type must be Full, TimeAveraged, BackTransformed or BoundaryScraping");
+            diag_type_str == "Full" || diag_type_str == "TimeAveraged" || diag_type_str == "FrequencyDomain" ||
+            diag_type_str == "BackTransformed" || diag_type_str == "BoundaryScraping",
+            "<diag>.diag_type must be Full, TimeAveraged, FrequencyDomain, BackTransformed or BoundaryScraping");
         if (diag_type_str == "Full") { diags_types[i] = DiagTypes::Full; }
         if (diag_type_str == "TimeAveraged") { diags_types[i] = DiagTypes::TimeAveraged; }
+        if (diag_type_str == "FrequencyDomain") { diags_types[i] = DiagTypes::FrequencyDomain; }
         if (diag_type_str == "BackTransformed") { diags_types[i] = DiagTypes::BackTransformed; }
         if (diag_type_str == "BoundaryScraping") { diags_types[i] = DiagTypes::BoundaryScraping; }
     }
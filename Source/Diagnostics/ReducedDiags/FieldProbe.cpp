@@ -7,6 +7,7 @@
 
 #include "FieldProbe.H"
 #include "FieldProbeParticleContainer.H"
+#include "Diagnostics/OpenPMDHelpFunction.H"
 #include "Fields.H"
 #include "Particles/Gather/FieldGather.H"
 #include "Particles/Pusher/GetAndSetPosition.H"
@@ -15,6 +16,7 @@
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
 #include <ablastr/fields/MultiFabRegister.H>
@@ -36,15 +38,26 @@
 #include <AMReX_StructOfArrays.H>
 #include <AMReX_Vector.H>
 
+#ifdef WARPX_USE_OPENPMD
+#   include <openPMD/openPMD.hpp>
+#endif
+
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#ifdef WARPX_USE_OPENPMD
+namespace io = openPMD;
+#endif
+
 using namespace amrex;
 using warpx::fields::FieldType;
 
@@ -141,6 +154,28 @@ FieldProbe::FieldProbe (const std::string& rd_name)
     utils::parser::queryWithParser(pp_rd_name, "interp_order", interp_order);
     pp_rd_name.query("do_moving_window_FP", do_moving_window_FP);
 
+    std::string output_format = "text";
+    pp_rd_name.query("output_format", output_format);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(output_format == "text" || output_format == "openpmd",
+        "FieldProbe: output_format must be text or openpmd");
+    m_openpmd_output = (output_format == "openpmd");
+    if (m_openpmd_output)
+    {
+#ifdef WARPX_USE_OPENPMD
+        pp_rd_name.query("openpmd_backend", m_openpmd_backend);
+        pp_rd_name.query("file_min_digits", m_file_min_digits);
+        // pick first available backend if default is chosen
+        if( m_openpmd_backend == "default" ) {
+            m_openpmd_backend = WarpXOpenPMDFileType();
+        }
+        utils::parser::queryWithParser(pp_rd_name, "buffer_steps", m_buffer_steps);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_buffer_steps >= 1,
+            "FieldProbe: buffer_steps must be at least 1");
+#else
+        WARPX_ABORT_WITH_MESSAGE("FieldProbe: output_format = openpmd needs openPMD-api compiled into WarpX, but was not found!");
+#endif
+    }
+
     bool raw_fields;
     const bool raw_fields_specified = pp_rd_name.query("raw_fields", raw_fields);
     if (raw_fields_specified) {
@@ -162,7 +197,7 @@ FieldProbe::FieldProbe (const std::string& rd_name)
     utils::parser::getWithParser(pp_algo, "particle_shape", particle_shape);
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(interp_order <= particle_shape ,
                                      "Field probe interp_order should be less than or equal to algo.particle_shape");
-    if (ParallelDescriptor::IOProcessor())
+    if (ParallelDescriptor::IOProcessor() && !m_openpmd_output)
     {
         if ( m_write_header )
         {
@@ -234,107 +269,103 @@ FieldProbe::FieldProbe (const std::string& rd_name)
     }
 } // end constructor
 
+FieldProbe::~FieldProbe ()
+{
+    // write the output steps that were accumulated since the last write, e.g. if the
+    // simulation was stopped before its last step
+    FlushBufferedData();
+}
+
 void FieldProbe::InitData ()
 {
     using namespace amrex::literals;
 
+    /* The probe points form a grid of n_outer x n_inner points, the position of the
+     * point of index ip being origin + outer_step * (ip / n_inner) + inner_step * (ip % n_inner).
+     * This allows each MPI rank to create its share of the points independently. */
+    amrex::Real origin[3]{x_probe, y_probe, z_probe};
+    amrex::Real outer_step[3]{0._rt, 0._rt, 0._rt};
+    amrex::Real inner_step[3]{0._rt, 0._rt, 0._rt};
+    amrex::Long n_outer = 1;
+    amrex::Long n_inner = 1;
+
+    if (m_probe_geometry == DetectorGeometry::Line)
+    {
+        // Final - initial / steps. Array contains dx, dy, dz
+        outer_step[0] = (x1_probe - x_probe) / (m_resolution - 1);
+        outer_step[1] = (y1_probe - y_probe) / (m_resolution - 1);
+        outer_step[2] = (z1_probe - z_probe) / (m_resolution - 1);
+        n_outer = m_resolution;
+    }
+    else if (m_probe_geometry == DetectorGeometry::Plane)
+    {
+        // ensure that input vectors are normalized
+        normalize(target_normal_x, target_normal_y, target_normal_z);
+        normalize(target_up_x, target_up_y, target_up_z);
+
+        // create vector orthonormal to input vectors
+        const amrex::Real orthotarget[3]{
+            target_normal_y * target_up_z - target_normal_z * target_up_y,
+            target_normal_z * target_up_x - target_normal_x * target_up_z,
+            target_normal_x * target_up_y - target_normal_y * target_up_x};
+
+        // find upper left and lower right bounds of detector
+        amrex::Real direction[3]{
+            orthotarget[0] - target_up_x,
+            orthotarget[1] - target_up_y,
+            orthotarget[2] - target_up_z};
+        normalize(direction[0], direction[1], direction[2]);
+        const amrex::Real uppercorner[3]{
+            x_probe - (direction[0] * detector_radius),
+            y_probe - (direction[1] * detector_radius),
+            z_probe - (direction[2] * detector_radius)};
+        const amrex::Real lowercorner[3]{
+            uppercorner[0] - (target_up_x * std::sqrt(2_rt) * detector_radius),
+            uppercorner[1] - (target_up_y * std::sqrt(2_rt) * detector_radius),
+            uppercorner[2] - (target_up_z * std::sqrt(2_rt) * detector_radius)};
+        const amrex::Real loweropposite[3]{
+            x_probe + (direction[0] * detector_radius),
+            y_probe + (direction[1] * detector_radius),
+            z_probe + (direction[2] * detector_radius)};
+
+        // Starting at the lowercorner point, step sideways (outer) and up (inner)
+        // to form a grid of equally spaced coordinate points
+        for (int idim = 0; idim < 3; ++idim)
+        {
+            origin[idim] = lowercorner[idim];
+            outer_step[idim] = (loweropposite[idim] - lowercorner[idim]) / (m_resolution - 1);
+            inner_step[idim] = (uppercorner[idim] - lowercorner[idim]) / (m_resolution - 1);
+        }
+        n_outer = m_resolution;
+        n_inner = m_resolution;
+    }
+
+    // each MPI rank creates a contiguous range of the probe points
+    const amrex::Long num_points = n_outer * n_inner;
+    const auto nprocs = static_cast<amrex::Long>(ParallelDescriptor::NProcs());
+    const auto myproc = static_cast<amrex::Long>(ParallelDescriptor::MyProc());
+    const amrex::Long ip_begin = num_points * myproc / nprocs;
+    const amrex::Long ip_end = num_points * (myproc + 1) / nprocs;
+
     // create 1D vector for X, Y, and Z coordinates of "particles"
     amrex::Vector<amrex::ParticleReal> xpos;
     amrex::Vector<amrex::ParticleReal> ypos;
     amrex::Vector<amrex::ParticleReal> zpos;
-
-    // for now, only one MPI rank adds probe "particles"
-    if (ParallelDescriptor::IOProcessor())
+    xpos.reserve(ip_end - ip_begin);
+    ypos.reserve(ip_end - ip_begin);
+    zpos.reserve(ip_end - ip_begin);
+    for (amrex::Long ip = ip_begin; ip < ip_end; ++ip)
     {
-        if (m_probe_geometry == DetectorGeometry::Point)
-        {
-            xpos.push_back(x_probe);
-            ypos.push_back(y_probe);
-            zpos.push_back(z_probe);
-        }
-        else if (m_probe_geometry == DetectorGeometry::Line)
-        {
-            xpos.reserve(m_resolution);
-            ypos.reserve(m_resolution);
-            zpos.reserve(m_resolution);
-
-            // Final - initial / steps. Array contains dx, dy, dz
-            const amrex::Real DetLineStepSize[3]{
-                    (x1_probe - x_probe) / (m_resolution - 1),
-                    (y1_probe - y_probe) / (m_resolution - 1),
-                    (z1_probe - z_probe) / (m_resolution - 1)};
-            for ( int step = 0; step < m_resolution; step++)
-            {
-                xpos.push_back(x_probe + (DetLineStepSize[0] * step));
-                ypos.push_back(y_probe + (DetLineStepSize[1] * step));
-                zpos.push_back(z_probe + (DetLineStepSize[2] * step));
-            }
-        }
-        else if (m_probe_geometry == DetectorGeometry::Plane)
-        {
-            std::size_t const res2 = std::size_t(m_resolution) * std::size_t(m_resolution);
-            xpos.reserve(res2);
-            ypos.reserve(res2);
-            zpos.reserve(res2);
-
-            // ensure that input vectors are normalized
-            normalize(target_normal_x, target_normal_y, target_normal_z);
-            normalize(target_up_x, target_up_y, target_up_z);
-
-            // create vector orthonormal to input vectors
-            const amrex::Real orthotarget[3]{
-                target_normal_y * target_up_z - target_normal_z * target_up_y,
-                target_normal_z * target_up_x - target_normal_x * target_up_z,
-                target_normal_x * target_up_y - target_normal_y * target_up_x};
-
-            // find upper left and lower right bounds of detector
-            amrex::Real direction[3]{
-                orthotarget[0] - target_up_x,
-                orthotarget[1] - target_up_y,
-                orthotarget[2] - target_up_z};
-            normalize(direction[0], direction[1], direction[2]);
-            const amrex::Real uppercorner[3]{
-                x_probe - (direction[0] * detector_radius),
-                y_probe - (direction[1] * detector_radius),
-                z_probe - (direction[2] * detector_radius)};
-            const amrex::Real lowercorner[3]{
-                uppercorner[0] - (target_up_x * std::sqrt(2_rt) * detector_radius),
-                uppercorner[1] - (target_up_y * std::sqrt(2_rt) * detector_radius),
-                uppercorner[2] - (target_up_z * std::sqrt(2_rt) * detector_radius)};
-            const amrex::Real loweropposite[3]{
-                x_probe + (direction[0] * detector_radius),
-                y_probe + (direction[1] * detector_radius),
-                z_probe + (direction[2] * detector_radius)};
-
-            // create array containing point-to-point step size
-            const amrex::Real SideStepSize[3]{
-                (loweropposite[0] - lowercorner[0]) / (m_resolution - 1),
-                (loweropposite[1] - lowercorner[1]) / (m_resolution - 1),
-                (loweropposite[2] - lowercorner[2]) / (m_resolution - 1)};
-            const amrex::Real UpStepSize[3]{
-                (uppercorner[0] - lowercorner[0]) / (m_resolution - 1),
-                (uppercorner[1] - lowercorner[1]) / (m_resolution - 1),
-                (uppercorner[2] - lowercorner[2]) / (m_resolution - 1)};
-
-            amrex::Real temp_pos[3]{};
-            // Starting at the lowercorner point, step sideways and up to form
-            // a grid of equally spaced coordinate points
-            for ( int sidestep = 0; sidestep < m_resolution; sidestep++)
-            {
-                for ( int upstep = 0; upstep < m_resolution; upstep++)
-                {
-                    temp_pos[0] = lowercorner[0] + SideStepSize[0] * sidestep + UpStepSize[0] * upstep;
-                    temp_pos[1] = lowercorner[1] + SideStepSize[1] * sidestep + UpStepSize[1] * upstep;
-                    temp_pos[2] = lowercorner[2] + SideStepSize[2] * sidestep + UpStepSize[2] * upstep;
-                    xpos.push_back(temp_pos[0]);
-                    ypos.push_back(temp_pos[1]);
-                    zpos.push_back(temp_pos[2]);
-                }
-            }
-        }
+        const auto outer = static_cast<amrex::Real>(ip / n_inner);
+        const auto inner = static_cast<amrex::Real>(ip % n_inner);
+        xpos.push_back(origin[0] + outer_step[0] * outer + inner_step[0] * inner);
+        ypos.push_back(origin[1] + outer_step[1] * outer + inner_step[1] * inner);
+        zpos.push_back(origin[2] + outer_step[2] * outer + inner_step[2] * inner);
     }
-    // add particles on lev 0 to m_probe
-    m_probe.AddNParticles(0, xpos, ypos, zpos);
+
+    // add particles on lev 0 to m_probe, numbered by their index in the grid of probe points
+    // (starting at 1), and move them to the MPI ranks owning their positions
+    m_probe.AddNParticles(0, xpos, ypos, zpos, ip_begin + 1);
 }
 
 void FieldProbe::LoadBalance ()
@@ -382,6 +413,9 @@ void FieldProbe::ComputeDiags (int step)
     // get number of mesh-refinement levels
     const auto nLevel = warpx.finestLevel() + 1;
 
+    // size of the openPMD buffer before the data of this step are added
+    const std::size_t buffered_size_before = m_buffered_data.size();
+
     using ablastr::fields::Direction;
 
     // loop over refinement levels
@@ -558,12 +592,20 @@ void FieldProbe::ComputeDiags (int step)
                     // This could be optimized by using shared memory.
                     amrex::Gpu::DeviceVector<amrex::Real> dv(np*noutputs);
                     amrex::Real* dvp = dv.data();
+                    // the ids are also kept as integers for the openPMD output, since
+                    // amrex::Real cannot represent all of them in single precision
+                    amrex::Gpu::DeviceVector<std::uint64_t> dids(m_openpmd_output ? np : 0);
+                    std::uint64_t* didsp = dids.data();
+                    const bool store_ids = m_openpmd_output;
                     amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long ip)
                     {
                         amrex::ParticleReal xp, yp, zp;
                         getPosition(ip, xp, yp, zp);
                         long idx = ip*noutputs;
-                        dvp[idx++] = amrex::ParticleIDWrapper{idcpu[ip]};  // all particles created on IO cpu
+                        dvp[idx++] = amrex::ParticleIDWrapper{idcpu[ip]};  // index of the probe point, starting at 1
+                        if (store_ids) {
+                            didsp[ip] = static_cast<std::uint64_t>(amrex::Long(amrex::ParticleIDWrapper{idcpu[ip]}));
+                        }
                         dvp[idx++] = xp;
                         dvp[idx++] = yp;
                         dvp[idx++] = zp;
@@ -579,6 +621,12 @@ void FieldProbe::ComputeDiags (int step)
                     m_data.resize(oldsize + dv.size());
                     amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost,
                                           dv.begin(), dv.end(), &m_data[oldsize]);
+                    if (store_ids) {
+                        auto const oldsize_ids = m_buffered_ids.size();
+                        m_buffered_ids.resize(oldsize_ids + dids.size());
+                        amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost,
+                                              dids.begin(), dids.end(), &m_buffered_ids[oldsize_ids]);
+                    }
                     Gpu::streamSynchronize();
                 /* m_data now contains up-to-date values for:
                  *  [x, y, z, Ex, Ey, Ez, Bx, By, Bz, and S] */
@@ -586,7 +634,12 @@ void FieldProbe::ComputeDiags (int step)
             }
         } // end particle iterator loop
 
-        if (m_intervals.contains(step+1))
+        if (m_intervals.contains(step+1) && m_openpmd_output)
+        {
+            // keep the data on this MPI rank until the buffered steps are written
+            m_buffered_data.insert(m_buffered_data.end(), m_data.begin(), m_data.end());
+        }
+        else if (m_intervals.contains(step+1))
         {
             // returns total number of mpi notes into mpisize
             const int mpisize = ParallelDescriptor::NProcs();
@@ -628,13 +681,30 @@ void FieldProbe::ComputeDiags (int step)
                                                amrex::ParallelDescriptor::IOProcessorNumber());
         }
     }// end loop over refinement levels
-    // make sure data is in m_data on the IOProcessor
-    // TODO: In the future, we want to use a parallel I/O method instead (plotfiles or openPMD)
+    // make sure data is in m_data on the IOProcessor (text output),
+    // or in m_buffered_data on each MPI rank (openPMD output)
+    if (m_intervals.contains(step+1) && m_openpmd_output)
+    {
+        m_buffered_steps.push_back(step+1);
+        m_buffered_times.push_back(warpx.gett_new(0));
+        m_buffered_np.push_back(
+            static_cast<amrex::Long>((m_buffered_data.size() - buffered_size_before) / noutputs));
+
+        const bool last_step =
+            (step+1 >= warpx.maxStep()) || (warpx.gett_new(0) >= warpx.stopTime());
+        if (static_cast<int>(m_buffered_steps.size()) >= m_buffer_steps || last_step)
+        {
+            FlushBufferedData();
+        }
+    }
     m_last_compute_step = step;
 } // end void FieldProbe::ComputeDiags
 
 void FieldProbe::WriteToFile (int step) const
 {
+    // the openPMD output is written by all MPI ranks in FlushBufferedData
+    if (m_openpmd_output) { return; }
+
     if (!(ProbeInDomain() && amrex::ParallelDescriptor::IOProcessor())) { return; }
 
     // loop over num valid particles to find the lowest particle ID for later sorting
@@ -686,3 +756,136 @@ void FieldProbe::WriteToFile (int step) const
     // close file
     ofs.close();
 }
+
+void FieldProbe::FlushBufferedData ()
+{
+    if (m_buffered_steps.empty()) { return; }
+
+#ifdef WARPX_USE_OPENPMD
+    WARPX_PROFILE("FieldProbe::FlushBufferedData()");
+
+    if (!m_series)
+    {
+        std::string filename = "openpmd";
+        const std::string fileSuffix = std::string("_%0") + std::to_string(m_file_min_digits) + std::string("T");
+        filename = filename.append(fileSuffix).append(".").append(m_openpmd_backend);
+
+        // transform paths for Windows
+        #ifdef _WIN32
+            const std::string filepath = openPMD::auxiliary::replace_all(
+                m_path + m_rd_name + "/" + filename, "/", "\\");
+        #else
+            const std::string filepath = m_path + m_rd_name + "/" + filename;
+        #endif
+
+        if (ParallelDescriptor::NProcs() > 1) {
+#if defined(AMREX_USE_MPI)
+            m_series = std::make_unique<io::Series>(
+                filepath, io::Access::CREATE, ParallelDescriptor::Communicator());
+#else
+            WARPX_ABORT_WITH_MESSAGE("openPMD-api not built with MPI support!");
+#endif
+        } else {
+            m_series = std::make_unique<io::Series>(filepath, io::Access::CREATE);
+        }
+        m_series->setIterationEncoding(io::IterationEncoding::fileBased);
+        m_series->setSoftware("WarpX", WarpX::Version());
+    }
+
+    // number of probe points of all MPI ranks for all the buffered steps,
+    // used for the total size of the records and the offset of the chunk of this rank
+    const auto nsteps = static_cast<int>(m_buffered_steps.size());
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int myproc = ParallelDescriptor::MyProc();
+    amrex::Vector<amrex::Long> all_np(static_cast<std::size_t>(nsteps) * nprocs);
+    ParallelAllGather::AllGather(m_buffered_np.data(), nsteps, all_np.data(),
+                                 ParallelDescriptor::Communicator());
+
+    // the values are integrated over time, hence their unit is multiplied by seconds
+    const double time_power = m_field_probe_integrate ? 1. : 0.;
+    const std::map<io::UnitDimension, double> E_unit{
+        {io::UnitDimension::L, 1.}, {io::UnitDimension::M, 1.},
+        {io::UnitDimension::T, -3. + time_power}, {io::UnitDimension::I, -1.}};
+    const std::map<io::UnitDimension, double> B_unit{
+        {io::UnitDimension::M, 1.}, {io::UnitDimension::T, -2. + time_power},
+        {io::UnitDimension::I, -1.}};
+    const std::map<io::UnitDimension, double> S_unit{
+        {io::UnitDimension::M, 1.}, {io::UnitDimension::T, -3. + time_power}};
+
+    std::uint64_t row_offset = 0;
+    for (int istep = 0; istep < nsteps; ++istep)
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t total_np = 0;
+        for (int iproc = 0; iproc < nprocs; ++iproc) {
+            const auto np = static_cast<std::uint64_t>(all_np[iproc*nsteps + istep]);
+            if (iproc < myproc) { offset += np; }
+            total_np += np;
+        }
+        const auto np = static_cast<std::uint64_t>(m_buffered_np[istep]);
+
+        auto it = m_series->iterations[m_buffered_steps[istep]];
+        it.setTime(m_buffered_times[istep]);
+        auto probe = it.particles["probe"];
+
+        const io::Dataset real_dataset(io::determineDatatype<amrex::Real>(), {total_np});
+        const io::Dataset id_dataset(io::determineDatatype<std::uint64_t>(), {total_np});
+
+        // stores the column icol of the buffered rows of this step as the chunk of this rank
+        auto store_column = [&] (io::RecordComponent& rc, int icol)
+        {
+            rc.resetDataset(real_dataset);
+            if (np == 0) { return; }
+            std::shared_ptr<amrex::Real> column(new amrex::Real[np], std::default_delete<amrex::Real[]>());
+            for (std::uint64_t ip = 0; ip < np; ++ip) {
+                column.get()[ip] = m_buffered_data[(row_offset + ip)*noutputs + icol];
+            }
+            rc.storeChunk(column, {offset}, {np});
+        };
+
+        // columns of the buffered rows: id, x, y, z, Ex, Ey, Ez, Bx, By, Bz, S
+        // (the id is written from m_buffered_ids, which holds it exactly)
+        auto id = probe["id"][io::RecordComponent::SCALAR];
+        id.resetDataset(id_dataset);
+        if (np > 0) {
+            std::shared_ptr<std::uint64_t> ids(new std::uint64_t[np], std::default_delete<std::uint64_t[]>());
+            for (std::uint64_t ip = 0; ip < np; ++ip) {
+                ids.get()[ip] = m_buffered_ids[row_offset + ip];
+            }
+            id.storeChunk(ids, {offset}, {np});
+        }
+        const std::vector<std::string> components{"x", "y", "z"};
+        for (int icomp = 0; icomp < 3; ++icomp) {
+            auto position = probe["position"][components[icomp]];
+            store_column(position, 1 + icomp);
+            auto position_offset = probe["positionOffset"][components[icomp]];
+            position_offset.resetDataset(real_dataset);
+            position_offset.makeConstant(0._rt);
+            auto E = probe["E"][components[icomp]];
+            store_column(E, 4 + icomp);
+            auto B = probe["B"][components[icomp]];
+            store_column(B, 7 + icomp);
+        }
+        auto S = probe["S"][io::RecordComponent::SCALAR];
+        store_column(S, 10);
+
+        probe["position"].setUnitDimension({{io::UnitDimension::L, 1.}});
+        probe["positionOffset"].setUnitDimension({{io::UnitDimension::L, 1.}});
+        probe["E"].setUnitDimension(E_unit);
+        probe["B"].setUnitDimension(B_unit);
+        probe["S"].setUnitDimension(S_unit);
+
+        row_offset += np;
+    }
+    m_series->flush();
+    for (int istep = 0; istep < nsteps; ++istep) {
+        m_series->iterations[m_buffered_steps[istep]].close();
+    }
+#endif
+
+    m_buffered_data.clear();
+    m_buffered_ids.clear();
+    m_buffered_steps.clear();
+    m_buffered_times.clear();
+    m_buffered_np.clear();
+}
@@ -68,7 +68,8 @@ void
 FieldProbeParticleContainer::AddNParticles (int lev,
                                             amrex::Vector<amrex::ParticleReal> const & x,
                                             amrex::Vector<amrex::ParticleReal> const & y,
-                                            amrex::Vector<amrex::ParticleReal> const & z)
+                                            amrex::Vector<amrex::ParticleReal> const & z,
+                                            amrex::Long first_id)
 {
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(lev == 0, "AddNParticles: only lev=0 is supported yet.");
     AMREX_ALWAYS_ASSERT(x.size() == y.size());
@@ -101,7 +102,7 @@ FieldProbeParticleContainer::AddNParticles (int lev,
     for (int i = 0; i < np; i++)
     {
         auto & idcpu_data = pinned_tile.GetStructOfArrays().GetIdCPUData();
-        idcpu_data.push_back(amrex::SetParticleIDandCPU(ParticleType::NextID(), ParallelDescriptor::MyProc()));
+        idcpu_data.push_back(amrex::SetParticleIDandCPU(first_id + i, 0));
     }
 
     // write Real attributes (SoA) to particle initialized zero
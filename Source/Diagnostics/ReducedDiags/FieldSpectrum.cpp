@@ -0,0 +1,399 @@
+/* Copyright 2026 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "FieldSpectrum.H"
+
+#include "Diagnostics/OpenPMDHelpFunction.H"
+#ifdef WARPX_USE_FFT
+#   include "Diagnostics/ComputeDiagFunctors/SpectrumFunctor.H"
+#endif
+#include "Fields.H"
+#include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <ablastr/fields/MultiFabRegister.H>
+
+#include <AMReX.H>
+#include <AMReX_Array.H>
+#include <AMReX_Box.H>
+#include <AMReX_Config.H>
+#include <AMReX_Extension.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_Math.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+
+#ifdef WARPX_USE_OPENPMD
+#   include <openPMD/openPMD.hpp>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef WARPX_USE_OPENPMD
+namespace io = openPMD;
+#endif
+
+using namespace amrex;
+using warpx::fields::FieldType;
+
+namespace
+{
+    /** Field and direction of the field components whose spectrum can be computed */
+    const std::map<std::string, std::pair<FieldType, int>> spectrum_fields{
+        {"Ex", {FieldType::Efield_aux, 0}}, {"Ey", {FieldType::Efield_aux, 1}}, {"Ez", {FieldType::Efield_aux, 2}},
+        {"Bx", {FieldType::Bfield_aux, 0}}, {"By", {FieldType::Bfield_aux, 1}}, {"Bz", {FieldType::Bfield_aux, 2}},
+        {"jx", {FieldType::current_fp, 0}}, {"jy", {FieldType::current_fp, 1}}, {"jz", {FieldType::current_fp, 2}}
+    };
+
+    /** Unit of the spectrum of a field component, for the header of the text output */
+    std::string spectrum_unit (std::string const& field_name)
+    {
+        if (field_name[0] == 'E') { return "(V^2/m^2)"; }
+        if (field_name[0] == 'B') { return "(T^2)"; }
+        return "(A^2/m^4)";
+    }
+}
+
+// constructor
+FieldSpectrum::FieldSpectrum (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+#if defined(WARPX_DIM_RZ)
+    WARPX_ABORT_WITH_MESSAGE(
+        "FieldSpectrum reduced diagnostics not implemented in RZ geometry");
+#endif
+#if !defined(WARPX_USE_FFT)
+    WARPX_ABORT_WITH_MESSAGE(
+        "FieldSpectrum reduced diagnostics needs WarpX to be compiled with FFT support (WarpX_FFT=ON)");
+#endif
+
+    const ParmParse pp_rd_name(rd_name);
+
+    // read the field components
+    pp_rd_name.getarr("fields", m_field_names);
+    for (auto const& field_name : m_field_names) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(spectrum_fields.count(field_name) != 0,
+            "FieldSpectrum: unknown field " + field_name
+            + ". Valid fields are Ex, Ey, Ez, Bx, By, Bz, jx, jy and jz.");
+    }
+
+    // read the window
+    pp_rd_name.query("window", m_window);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_window == "none" || m_window == "hann",
+        "FieldSpectrum: window must be none or hann");
+
+    // read the type of spectrum
+    std::string spectrum_type = "radial";
+    pp_rd_name.query("spectrum_type", spectrum_type);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(spectrum_type == "radial" || spectrum_type == "grid",
+        "FieldSpectrum: spectrum_type must be radial or grid");
+    m_radial = (spectrum_type == "radial");
+
+    if (!m_radial)
+    {
+#ifdef WARPX_USE_OPENPMD
+        pp_rd_name.query("openpmd_backend", m_openpmd_backend);
+        pp_rd_name.query("file_min_digits", m_file_min_digits);
+        // pick first available backend if default is chosen
+        if( m_openpmd_backend == "default" ) {
+            m_openpmd_backend = WarpXOpenPMDFileType();
+        }
+#else
+        WARPX_ABORT_WITH_MESSAGE("FieldSpectrum: spectrum_type = grid needs openPMD-api compiled into WarpX, but was not found!");
+#endif
+        return;
+    }
+
+    // read bin parameters; by default, the bins extend to the largest |k| of the grid
+    utils::parser::getWithParser(pp_rd_name, "bin_number", m_bin_num);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_bin_num > 0, "FieldSpectrum: bin_number must be positive");
+    const auto dx = WarpX::GetInstance().Geom(0).CellSizeArray();
+    amrex::Real k2_max = 0.0_rt;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        k2_max += (MathConst::pi/dx[idim]) * (MathConst::pi/dx[idim]);
+    }
+    m_bin_max = std::sqrt(k2_max);
+    utils::parser::queryWithParser(pp_rd_name, "bin_max", m_bin_max);
+    const amrex::Real bin_size = m_bin_max / m_bin_num;
+
+    // resize data array
+    m_data.resize(m_field_names.size()*m_bin_num, 0.0_rt);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (auto const& field_name : m_field_names)
+            {
+                for (int i = 0; i < m_bin_num; ++i)
+                {
+                    ofs << m_sep;
+                    ofs << "[" << c++ << "]";
+                    const Real k = bin_size*(Real(i)+0.5_rt);
+                    ofs << field_name + "_k=" + std::to_string(k) + "(1/m)"
+                        + spectrum_unit(field_name);
+                }
+            }
+            ofs << "\n";
+            // close file
+            ofs.close();
+        }
+    }
+}
+// end constructor
+
+void FieldSpectrum::InitData ()
+{
+    DefineFunctors();
+}
+
+void FieldSpectrum::LoadBalance ()
+{
+    DefineFunctors();
+}
+
+void FieldSpectrum::DefineFunctors ()
+{
+#ifdef WARPX_USE_FFT
+    auto & warpx = WarpX::GetInstance();
+    int const lev = 0;
+
+    // one FFT plan, shared by all the field components
+    auto r2c = std::make_shared<SpectrumFunctor::R2C>(warpx.Geom(lev).Domain());
+    auto const [spectral_ba, spectral_dm] = r2c->getSpectralDataLayout();
+    m_spectrum = amrex::MultiFab(spectral_ba, spectral_dm, static_cast<int>(m_field_names.size()), 0);
+
+    const auto window = (m_window == "hann") ? SpectrumWindow::hann : SpectrumWindow::none;
+    m_spectrum_functors.clear();
+    for (auto const& field_name : m_field_names) {
+        auto const& [field_type, dir] = spectrum_fields.at(field_name);
+        amrex::MultiFab const* mf_src = warpx.m_fields.get(field_type, ablastr::fields::Direction{dir}, lev);
+        m_spectrum_functors.push_back(std::make_unique<SpectrumFunctor>(
+            mf_src, lev, amrex::IntVect(1), r2c, window));
+    }
+#endif
+}
+
+void FieldSpectrum::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    WARPX_PROFILE("FieldSpectrum::ComputeDiags()");
+
+    // compute the spectrum of each field component
+    auto const nfields = static_cast<int>(m_field_names.size());
+    for (int icomp = 0; icomp < nfields; ++icomp) {
+        (*m_spectrum_functors[icomp])(m_spectrum, icomp);
+    }
+
+    if (!m_radial)
+    {
+        WriteGridSpectra(step);
+        return;
+    }
+
+    // wave vector of the spectral indices: the first axis only contains the modes
+    // k >= 0 (real-to-complex FFT), the other axes contain the negative modes above n/2
+    const amrex::Geometry& geom = WarpX::GetInstance().Geom(0);
+    const auto dx = geom.CellSizeArray();
+    const amrex::IntVect n = geom.Domain().length();
+    amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dk;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        dk[idim] = 2._rt*MathConst::pi / (n[idim]*dx[idim]);
+    }
+
+    // declare local variables
+    auto const num_bins = m_bin_num;
+    Real const bin_max = m_bin_max;
+    Real const bin_size = m_bin_max / m_bin_num;
+
+    // zero-out old data on the host
+    std::fill(m_data.begin(), m_data.end(), amrex::Real(0.0));
+    amrex::Gpu::DeviceVector< amrex::Real > d_data( m_data.size(), 0.0 );
+    amrex::Real* const AMREX_RESTRICT dptr_data = d_data.dataPtr();
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(m_spectrum, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        auto const& spectrum = m_spectrum.const_array(mfi);
+        amrex::ParallelFor(mfi.tilebox(),
+            [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            const amrex::IntVect iv(AMREX_D_DECL(i, j, k));
+            amrex::Real k2 = 0._rt;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const int m = (idim > 0 && 2*iv[idim] > n[idim]) ? iv[idim] - n[idim] : iv[idim];
+                k2 += (m*dk[idim]) * (m*dk[idim]);
+            }
+            // determine the bin; the modes on the upper edge of the last bin (such as the
+            // corner of the grid with the default bin_max) are counted in the last bin
+            amrex::Real const kabs = std::sqrt(k2);
+            if ( kabs > bin_max*(1._rt + 1.e-6_rt) ) { return; } // discard if out-of-range
+            int const bin = amrex::min(int(std::floor(kabs/bin_size)), num_bins-1);
+
+            // the modes with 0 < k_0 < k_Nyquist also stand for their complex conjugate (-k)
+            amrex::Real const weight = (iv[0] > 0 && 2*iv[0] != n[0]) ? 2._rt : 1._rt;
+            for (int icomp = 0; icomp < nfields; ++icomp) {
+                amrex::HostDevice::Atomic::Add(&dptr_data[icomp*num_bins + bin],
+                                               weight*spectrum(i, j, k, icomp));
+            }
+        });
+    }
+
+    // blocking copy from device to host
+    amrex::Gpu::copy(amrex::Gpu::deviceToHost,
+        d_data.begin(), d_data.end(), m_data.begin());
+
+    // reduced sum over mpi ranks
+    ParallelDescriptor::ReduceRealSum
+        (m_data.data(), static_cast<int>(m_data.size()), ParallelDescriptor::IOProcessorNumber());
+}
+// end void FieldSpectrum::ComputeDiags
+
+void FieldSpectrum::WriteToFile (int step) const
+{
+    // the spectra on the k-grid are written by all MPI ranks in ComputeDiags
+    if (!m_radial) { return; }
+
+    ReducedDiags::WriteToFile(step);
+}
+
+void FieldSpectrum::WriteGridSpectra (int step) const
+{
+#ifdef WARPX_USE_OPENPMD
+    WARPX_PROFILE("FieldSpectrum::WriteGridSpectra()");
+
+    std::string filename = "openpmd";
+    const std::string fileSuffix = std::string("_%0") + std::to_string(m_file_min_digits) + std::string("T");
+    filename = filename.append(fileSuffix).append(".").append(m_openpmd_backend);
+
+    // transform paths for Windows
+    #ifdef _WIN32
+        const std::string filepath = openPMD::auxiliary::replace_all(
+            m_path + m_rd_name + "/" + filename, "/", "\\");
+    #else
+        const std::string filepath = m_path + m_rd_name + "/" + filename;
+    #endif
+
+    // Create the OpenPMD series, written by all MPI ranks
+    std::unique_ptr<io::Series> series;
+    if (ParallelDescriptor::NProcs() > 1) {
+#if defined(AMREX_USE_MPI)
+        series = std::make_unique<io::Series>(
+            filepath, io::Access::CREATE, ParallelDescriptor::Communicator());
+#else
+        WARPX_ABORT_WITH_MESSAGE("openPMD-api not built with MPI support!");
+#endif
+    } else {
+        series = std::make_unique<io::Series>(filepath, io::Access::CREATE);
+    }
+    auto i = series->iterations[step + 1];
+
+    // Get time at level 0
+    auto & warpx = WarpX::GetInstance();
+    i.setTime(warpx.gett_new(0));
+
+    // openPMD axes are ordered from the slowest to the fastest varying index
+    const amrex::Geometry& geom = warpx.Geom(0);
+    const auto dx = geom.CellSizeArray();
+    const amrex::IntVect n = geom.Domain().length();
+#if defined(WARPX_DIM_3D)
+    const std::vector<std::string> axis_labels{"kz", "ky", "kx"};
+#elif defined(WARPX_DIM_XZ)
+    const std::vector<std::string> axis_labels{"kz", "kx"};
+#else
+    const std::vector<std::string> axis_labels{"kz"};
+#endif
+    std::vector<double> grid_spacing;
+    std::vector<double> grid_offset;
+    io::Extent global_extent;
+    const amrex::Box spectral_domain = m_spectrum.boxArray().minimalBox();
+    for (int idim = AMREX_SPACEDIM-1; idim >= 0; --idim) {
+        grid_spacing.push_back(2.*MathConst::pi / (n[idim]*dx[idim]));
+        grid_offset.push_back(0.);
+        global_extent.push_back(static_cast<std::uint64_t>(spectral_domain.length(idim)));
+    }
+
+    auto const nfields = static_cast<int>(m_field_names.size());
+    for (int icomp = 0; icomp < nfields; ++icomp)
+    {
+        auto const& field_name = m_field_names[icomp];
+        auto mesh = i.meshes[field_name + "_spectrum"];
+        mesh.setAttribute("window", m_window);
+        mesh.setAxisLabels(axis_labels);
+        mesh.setGridSpacing(grid_spacing);
+        mesh.setGridGlobalOffset(grid_offset);
+        if (field_name[0] == 'E') {
+            mesh.setUnitDimension({{io::UnitDimension::L, 2.}, {io::UnitDimension::M, 2.},
+                                   {io::UnitDimension::T, -6.}, {io::UnitDimension::I, -2.}});
+        } else if (field_name[0] == 'B') {
+            mesh.setUnitDimension({{io::UnitDimension::M, 2.}, {io::UnitDimension::T, -4.},
+                                   {io::UnitDimension::I, -2.}});
+        } else {
+            mesh.setUnitDimension({{io::UnitDimension::L, -4.}, {io::UnitDimension::I, 2.}});
+        }
+
+        auto data = mesh[io::RecordComponent::SCALAR];
+        data.setPosition(std::vector<double>(AMREX_SPACEDIM, 0.));
+        data.resetDataset(io::Dataset(io::determineDatatype<amrex::Real>(), global_extent));
+
+        // each MPI rank stores its own boxes
+        for (amrex::MFIter mfi(m_spectrum); mfi.isValid(); ++mfi)
+        {
+            const amrex::Box& box = mfi.validbox();
+            io::Offset chunk_offset;
+            io::Extent chunk_extent;
+            for (int idim = AMREX_SPACEDIM-1; idim >= 0; --idim) {
+                chunk_offset.push_back(static_cast<std::uint64_t>(box.smallEnd(idim) - spectral_domain.smallEnd(idim)));
+                chunk_extent.push_back(static_cast<std::uint64_t>(box.length(idim)));
+            }
+            const auto npts = static_cast<std::size_t>(box.numPts());
+            std::shared_ptr<amrex::Real> chunk(new amrex::Real[npts], std::default_delete<amrex::Real[]>());
+            amrex::Real const* src = m_spectrum[mfi].dataPtr(icomp);
+            amrex::Gpu::copy(amrex::Gpu::deviceToHost, src, src + npts, chunk.get());
+            data.storeChunk(chunk, chunk_offset, chunk_extent);
+        }
+    }
+
+    series->flush();
+    i.close();
+    series->close();
+#else
+    amrex::ignore_unused(step);
+    WARPX_ABORT_WITH_MESSAGE("FieldSpectrum: Needs openPMD-api compiled into WarpX, but was not found!");
+#endif
+}
@@ -14,6 +14,7 @@
 #include "FieldMaximum.H"
 #include "FieldMomentum.H"
 #include "FieldProbe.H"
+#include "FieldSpectrum.H"
 #include "FieldReduction.H"
 #include "LoadBalanceCosts.H"
 #include "LoadBalanceEfficiency.H"
@@ -21,12 +22,19 @@
 #include "ParticleExtrema.H"
 #include "ParticleHistogram.H"
 #include "ParticleHistogram2D.H"
+#include "ParticleHistogramND.H"
 #include "ParticleMomentum.H"
 #include "ParticleNumber.H"
 #include "RhoMaximum.H"
 #include "Timestep.H"
+#include "EmbeddedBoundary/Enabled.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Python/callbacks.H"
 #include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
 
 #include <AMReX.H>
 #include <AMReX_ParallelDescriptor.H>
@@ -61,12 +69,14 @@ MultiReducedDiags::MultiReducedDiags ()
             {"ParticleExtrema",       [](CS s){return std::make_unique<ParticleExtrema>(s);}},
             {"ParticleHistogram",     [](CS s){return std::make_unique<ParticleHistogram>(s);}},
             {"ParticleHistogram2D",   [](CS s){return std::make_unique<ParticleHistogram2D>(s);}},
+            {"ParticleHistogramND",   [](CS s){return std::make_unique<ParticleHistogramND>(s);}},
             {"ParticleMomentum",      [](CS s){return std::make_unique<ParticleMomentum>(s);}},
             {"ParticleNumber",        [](CS s){return std::make_unique<ParticleNumber>(s);}},
             {"FieldEnergy",           [](CS s){return std::make_unique<FieldEnergy>(s);}},
             {"FieldMaximum",          [](CS s){return std::make_unique<FieldMaximum>(s);}},
             {"FieldMomentum",         [](CS s){return std::make_unique<FieldMomentum>(s);}},
             {"FieldProbe",            [](CS s){return std::make_unique<FieldProbe>(s);}},
+            {"FieldSpectrum",         [](CS s){return std::make_unique<FieldSpectrum>(s);}},
             {"FieldReduction",        [](CS s){return std::make_unique<FieldReduction>(s);}},
             {"LoadBalanceCosts",      [](CS s){return std::make_unique<LoadBalanceCosts>(s);}},
             {"LoadBalanceEfficiency", [](CS s){return std::make_unique<LoadBalanceEfficiency>(s);}},
@@ -110,6 +120,41 @@ void MultiReducedDiags::LoadBalance () {
     }
 }
 
+void MultiReducedDiags::PrepareParticlePush (int step)
+{
+    bool use_push_moments = false;
+    for (auto const& rd : m_multi_rd)
+    {
+        use_push_moments = use_push_moments || (rd->m_use_push_moments && rd->m_intervals.contains(step+1));
+    }
+
+    // The sums are only valid if each particle is pushed exactly once in the step,
+    // which is not the case with implicit schemes or with subcycling
+    auto & warpx = WarpX::GetInstance();
+    use_push_moments = use_push_moments && (WarpX::evolve_scheme == EvolveScheme::Explicit)
+        && !(WarpX::do_subcycling && warpx.finestLevel() > 0);
+
+    // The particles of all the species can also be added, removed or modified before the
+    // reduced diagnostics are computed by the moving window, by the scraping at the
+    // embedded boundaries and by the Python callbacks called after the push.
+    // Otherwise, see WarpXParticleContainer::SetAccumulatePushMoments.
+    const bool has_python_callbacks_after_push =
+        IsPythonCallbackInstalled("afterdeposition") ||
+        IsPythonCallbackInstalled("afterBpush") ||
+        IsPythonCallbackInstalled("afterEpush") ||
+        IsPythonCallbackInstalled("beforeEsolve") ||
+        IsPythonCallbackInstalled("afterEsolve") ||
+        IsPythonCallbackInstalled("afterstep");
+    use_push_moments = use_push_moments && !WarpX::moving_window_active(step+1)
+        && !EB::enabled() && !has_python_callbacks_after_push;
+
+    auto & mypc = warpx.GetPartContainer();
+    for (int i_s = 0; i_s < mypc.nSpecies(); ++i_s)
+    {
+        mypc.GetParticleContainer(i_s).SetAccumulatePushMoments(use_push_moments);
+    }
+}
+
 // call functions to compute diags
 void MultiReducedDiags::ComputeDiags (int step)
 {
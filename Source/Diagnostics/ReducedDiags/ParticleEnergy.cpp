@@ -17,6 +17,7 @@
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_ParticleReduce.H>
 #include <AMReX_Particles.H>
 #include <AMReX_REAL.H>
@@ -49,6 +50,12 @@ ParticleEnergy::ParticleEnergy (const std::string& rd_name)
     // resize data array
     m_data.resize(2*nSpecies+2, 0.0_rt);
 
+    // Read whether the moments accumulated during the particle push are used
+    const ParmParse pp_rd("reduced_diags");
+    const ParmParse pp_rd_name(rd_name);
+    pp_rd.query("fuse_with_push", m_use_push_moments);
+    pp_rd_name.query("fuse_with_push", m_use_push_moments);
+
     // get species names (std::vector<std::string>)
     const auto species_names = mypc.GetSpeciesNames();
 
@@ -90,12 +97,19 @@ void ParticleEnergy::ComputeDiags (int step)
     // Check if the diags should be done
     if (!m_intervals.contains(step+1)) { return; }
 
+    // Get a reference to WarpX instance
+    auto & warpx = WarpX::GetInstance();
+
     // Get MultiParticleContainer class object
-    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+    const auto & mypc = warpx.GetPartContainer();
 
     // Get number of species
     const int nSpecies = mypc.nSpecies();
 
+    // The moments accumulated during the push are those of the particles at p^{n+1/2}:
+    // they are not used when the momenta were synchronized with the positions after the push
+    const bool synchronized = warpx.getis_synchronized();
+
     amrex::Real Wtot = 0.0_rt;
 
     // Loop over species
@@ -116,7 +130,14 @@ void ParticleEnergy::ComputeDiags (int step)
         // held by the current MPI rank for this species (loop over all boxes held by this MPI rank):
         // the result r is the tuple (Etot, Ws)
         amrex::ReduceOps<ReduceOpSum, ReduceOpSum> reduce_ops;
-        if(myspc.AmIA<PhysicalSpecies::photon>())
+        if (m_use_push_moments && myspc.accumulatePushMoments() && !synchronized)
+        {
+            // Sums already accumulated during the particle push
+            auto const moments = myspc.GetPushMoments();
+            Etot = moments[PushMomentIdx::energy];
+            Ws   = moments[PushMomentIdx::w];
+        }
+        else if(myspc.AmIA<PhysicalSpecies::photon>())
         {
             auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
                 myspc,
@@ -0,0 +1,376 @@
+/* Copyright 2026 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ParticleHistogramND.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Diagnostics/OpenPMDHelpFunction.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXConst.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Config.H>
+#include <AMReX_Extension.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_Math.H>
+#include <AMReX_ParIter.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+
+#ifdef AMREX_USE_OMP
+#   include <omp.h>
+#endif
+
+#ifdef WARPX_USE_OPENPMD
+#   include <openPMD/openPMD.hpp>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef WARPX_USE_OPENPMD
+namespace io = openPMD;
+#endif
+
+using namespace amrex;
+
+// constructor
+ParticleHistogramND::ParticleHistogramND (const std::string& rd_name)
+        : ReducedDiags{rd_name}
+{
+    ParmParse pp_rd_name(rd_name);
+
+    pp_rd_name.query("openpmd_backend", m_openpmd_backend);
+    pp_rd_name.query("file_min_digits", m_file_min_digits);
+    // pick first available backend if default is chosen
+    if( m_openpmd_backend == "default" ) {
+        m_openpmd_backend = WarpXOpenPMDFileType();
+    }
+    pp_rd_name.add("openpmd_backend", m_openpmd_backend);
+
+    // read species
+    std::string selected_species_name;
+    pp_rd_name.get("species",selected_species_name);
+
+    // get MultiParticleContainer class object
+    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+    // get species names (std::vector<std::string>)
+    auto const species_names = mypc.GetSpeciesNames();
+    // select species
+    for ( int i = 0; i < mypc.nSpecies(); ++i )
+    {
+        if ( selected_species_name == species_names[i] ){
+            m_selected_species_id = i;
+        }
+    }
+    // if m_selected_species_id is not modified
+    if ( m_selected_species_id == -1 ){
+        WARPX_ABORT_WITH_MESSAGE("Unknown species for ParticleHistogramND reduced diagnostic.");
+    }
+
+    // read the histograms
+    std::vector<std::string> histogram_names;
+    pp_rd_name.getarr("histograms", histogram_names);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!histogram_names.empty(),
+        rd_name + ".histograms must contain at least one histogram");
+
+    const std::vector<std::string> var_names = {"t","x","y","z","ux","uy","uz","w"};
+    for (auto const& histogram_name : histogram_names) {
+        const ParmParse pp_hist(rd_name + "." + histogram_name);
+        Histogram hist;
+        hist.name = histogram_name;
+        hist.offset = m_total_bins;
+
+        // read the axes
+        std::vector<std::string> axis_names;
+        pp_hist.getarr("axes", axis_names);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!axis_names.empty(),
+            rd_name + "." + histogram_name + ".axes must contain at least one axis");
+        for (auto const& axis_name : axis_names) {
+            const ParmParse pp_axis(rd_name + "." + histogram_name + "." + axis_name);
+            Axis axis;
+            axis.name = axis_name;
+            utils::parser::getWithParser(pp_axis, "bin_number", axis.bin_num);
+            utils::parser::getWithParser(pp_axis, "bin_max", axis.bin_max);
+            utils::parser::getWithParser(pp_axis, "bin_min", axis.bin_min);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(axis.bin_num > 0 && axis.bin_max > axis.bin_min,
+                "ParticleHistogramND: each axis must have bin_number > 0 and bin_max > bin_min");
+            axis.bin_size = (axis.bin_max - axis.bin_min) / axis.bin_num;
+            utils::parser::Store_parserString(pp_axis, "function(t,x,y,z,ux,uy,uz,w)",
+                                              axis.function_string);
+            axis.parser = std::make_unique<amrex::Parser>(
+                utils::parser::makeParser(axis.function_string, var_names));
+            hist.size *= axis.bin_num;
+            hist.axes.push_back(std::move(axis));
+        }
+
+        // Read optional filter
+        std::string buf;
+        if (pp_hist.query("filter_function(t,x,y,z,ux,uy,uz,w)", buf)) {
+            utils::parser::Store_parserString(
+                pp_hist, "filter_function(t,x,y,z,ux,uy,uz,w)", hist.filter_string);
+            hist.parser_filter = std::make_unique<amrex::Parser>(
+                utils::parser::makeParser(hist.filter_string, var_names));
+        }
+
+        // Read optional value function (the particle weight by default)
+        if (pp_hist.query("value_function(t,x,y,z,ux,uy,uz,w)", buf)) {
+            utils::parser::Store_parserString(
+                pp_hist, "value_function(t,x,y,z,ux,uy,uz,w)", hist.value_string);
+        }
+        hist.parser_value = std::make_unique<amrex::Parser>(
+            utils::parser::makeParser(hist.value_string, var_names));
+
+        m_total_bins += hist.size;
+        m_histograms.push_back(std::move(hist));
+    }
+
+    m_h_data.resize(m_total_bins, 0.0_rt);
+}
+// end constructor
+
+// function that computes the histograms
+void ParticleHistogramND::ComputeDiags (int step)
+{
+    // Judge if the diags should be done at this step
+    if (!m_intervals.contains(step+1)) { return; }
+
+    // get a reference to WarpX instance
+    auto & warpx = WarpX::GetInstance();
+
+    // get time at level 0
+    auto const t = warpx.gett_new(0);
+
+    // get MultiParticleContainer class object
+    const auto & mypc = warpx.GetPartContainer();
+
+    // get WarpXParticleContainer class object
+    auto & myspc = mypc.GetParticleContainer(m_selected_species_id);
+
+    // Flatten the description of all the histograms, such that the kernel can loop over them
+    using Executor = amrex::ParserExecutor<m_nvars>;
+    auto const num_hists = static_cast<int>(m_histograms.size());
+    amrex::Vector<Executor> h_axis_fun, h_value_fun, h_filter_fun;
+    amrex::Vector<amrex::Real> h_axis_min, h_axis_size;
+    amrex::Vector<int> h_axis_num, h_hist_axis_begin{0};
+    amrex::Vector<amrex::Long> h_hist_offset;
+    for (auto const& hist : m_histograms) {
+        for (auto const& axis : hist.axes) {
+            h_axis_fun.push_back(utils::parser::compileParser<m_nvars>(axis.parser.get()));
+            h_axis_min.push_back(axis.bin_min);
+            h_axis_size.push_back(axis.bin_size);
+            h_axis_num.push_back(axis.bin_num);
+        }
+        h_hist_axis_begin.push_back(static_cast<int>(h_axis_fun.size()));
+        h_hist_offset.push_back(hist.offset);
+        h_value_fun.push_back(utils::parser::compileParser<m_nvars>(hist.parser_value.get()));
+        h_filter_fun.push_back(utils::parser::compileParser<m_nvars>(hist.parser_filter.get()));
+    }
+    amrex::Gpu::DeviceVector<Executor> d_axis_fun(h_axis_fun.size());
+    amrex::Gpu::DeviceVector<Executor> d_value_fun(h_value_fun.size());
+    amrex::Gpu::DeviceVector<Executor> d_filter_fun(h_filter_fun.size());
+    amrex::Gpu::DeviceVector<amrex::Real> d_axis_min(h_axis_min.size());
+    amrex::Gpu::DeviceVector<amrex::Real> d_axis_size(h_axis_size.size());
+    amrex::Gpu::DeviceVector<int> d_axis_num(h_axis_num.size());
+    amrex::Gpu::DeviceVector<int> d_hist_axis_begin(h_hist_axis_begin.size());
+    amrex::Gpu::DeviceVector<amrex::Long> d_hist_offset(h_hist_offset.size());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_axis_fun.begin(), h_axis_fun.end(), d_axis_fun.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_value_fun.begin(), h_value_fun.end(), d_value_fun.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_filter_fun.begin(), h_filter_fun.end(), d_filter_fun.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_axis_min.begin(), h_axis_min.end(), d_axis_min.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_axis_size.begin(), h_axis_size.end(), d_axis_size.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_axis_num.begin(), h_axis_num.end(), d_axis_num.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice,
+        h_hist_axis_begin.begin(), h_hist_axis_begin.end(), d_hist_axis_begin.begin());
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_hist_offset.begin(), h_hist_offset.end(), d_hist_offset.begin());
+
+    Executor const* const AMREX_RESTRICT axis_fun = d_axis_fun.dataPtr();
+    Executor const* const AMREX_RESTRICT value_fun = d_value_fun.dataPtr();
+    Executor const* const AMREX_RESTRICT filter_fun = d_filter_fun.dataPtr();
+    amrex::Real const* const AMREX_RESTRICT axis_min = d_axis_min.dataPtr();
+    amrex::Real const* const AMREX_RESTRICT axis_size = d_axis_size.dataPtr();
+    int const* const AMREX_RESTRICT axis_num = d_axis_num.dataPtr();
+    int const* const AMREX_RESTRICT hist_axis_begin = d_hist_axis_begin.dataPtr();
+    amrex::Long const* const AMREX_RESTRICT hist_offset = d_hist_offset.dataPtr();
+
+    // On CPU, each OpenMP thread fills its own copy of the bins, without atomics,
+    // and the copies are summed after the loop. On GPU, the bins are updated with atomics.
+    amrex::Long const total_bins = m_total_bins;
+#if defined(AMREX_USE_OMP) && !defined(AMREX_USE_GPU)
+    int const num_copies = omp_get_max_threads();
+#else
+    int const num_copies = 1;
+#endif
+    amrex::Gpu::DeviceVector<amrex::Real> d_data(num_copies*total_bins, 0.0_rt);
+
+    int const nlevs = std::max(0, myspc.finestLevel()+1);
+    for (int lev = 0; lev < nlevs; ++lev) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        {
+#if defined(AMREX_USE_OMP) && !defined(AMREX_USE_GPU)
+            int const thread_num = omp_get_thread_num();
+#else
+            int const thread_num = 0;
+#endif
+            amrex::Real* const AMREX_RESTRICT dptr_data = d_data.dataPtr() + thread_num*total_bins;
+
+            for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+            {
+                auto const GetPosition = GetParticlePosition<PIdx>(pti);
+
+                auto & attribs = pti.GetAttribs();
+                ParticleReal* const AMREX_RESTRICT d_w = attribs[PIdx::w].dataPtr();
+                ParticleReal* const AMREX_RESTRICT d_ux = attribs[PIdx::ux].dataPtr();
+                ParticleReal* const AMREX_RESTRICT d_uy = attribs[PIdx::uy].dataPtr();
+                ParticleReal* const AMREX_RESTRICT d_uz = attribs[PIdx::uz].dataPtr();
+
+                long const np = pti.numParticles();
+
+                // Each particle is read once and added to all the histograms
+                amrex::ParallelFor(np,
+                    [=] AMREX_GPU_DEVICE(long i)
+                {
+                    amrex::ParticleReal x, y, z;
+                    GetPosition(i, x, y, z);
+                    auto const w  = (amrex::Real)d_w[i];
+                    auto const ux = d_ux[i] / PhysConst::c;
+                    auto const uy = d_uy[i] / PhysConst::c;
+                    auto const uz = d_uz[i] / PhysConst::c;
+
+                    for (int ih = 0; ih < num_hists; ++ih) {
+                        // don't count a particle if it is filtered out
+                        if (filter_fun[ih]) {
+                            if (!static_cast<bool>(filter_fun[ih](t, x, y, z, ux, uy, uz, w))) {
+                                continue;
+                            }
+                        }
+
+                        // determine particle bin, the first axis being the fastest varying
+                        amrex::Long bin = 0;
+                        amrex::Long stride = 1;
+                        bool in_range = true;
+                        for (int ia = hist_axis_begin[ih]; ia < hist_axis_begin[ih+1]; ++ia) {
+                            auto const f = axis_fun[ia](t, x, y, z, ux, uy, uz, w);
+                            int const bin_axis = int(Math::floor((f-axis_min[ia])/axis_size[ia]));
+                            if ( bin_axis<0 || bin_axis>=axis_num[ia] ) { // discard if out-of-range
+                                in_range = false;
+                                break;
+                            }
+                            bin += bin_axis*stride;
+                            stride *= axis_num[ia];
+                        }
+                        if (!in_range) { continue; }
+
+                        auto const value = static_cast<amrex::Real>(value_fun[ih](t, x, y, z, ux, uy, uz, w));
+                        amrex::Gpu::Atomic::AddNoRet(&dptr_data[hist_offset[ih] + bin], value);
+                    }
+                });
+            }
+        }
+    }
+
+    // Copy data from GPU memory and sum the copies of the threads
+    amrex::Vector<amrex::Real> h_data(num_copies*total_bins);
+    amrex::Gpu::copy(amrex::Gpu::deviceToHost, d_data.begin(), d_data.end(), h_data.begin());
+    std::copy(h_data.begin(), h_data.begin() + total_bins, m_h_data.begin());
+    for (int icopy = 1; icopy < num_copies; ++icopy) {
+        for (amrex::Long ibin = 0; ibin < total_bins; ++ibin) {
+            m_h_data[ibin] += h_data[icopy*total_bins + ibin];
+        }
+    }
+
+    // reduced sum over mpi ranks
+    ParallelDescriptor::ReduceRealSum
+            (m_h_data.data(), static_cast<int>(m_h_data.size()), ParallelDescriptor::IOProcessorNumber());
+}
+// end void ParticleHistogramND::ComputeDiags
+
+void ParticleHistogramND::WriteToFile (int step) const
+{
+#ifdef WARPX_USE_OPENPMD
+    // only IO processor writes
+    if ( !ParallelDescriptor::IOProcessor() ) { return; }
+
+    // TODO: support different filename templates
+    std::string filename = "openpmd";
+    // TODO: support also group-based encoding
+    const std::string fileSuffix = std::string("_%0") + std::to_string(m_file_min_digits) + std::string("T");
+    filename = filename.append(fileSuffix).append(".").append(m_openpmd_backend);
+
+    // transform paths for Windows
+    #ifdef _WIN32
+        const std::string filepath = openPMD::auxiliary::replace_all(
+            m_path + m_rd_name + "/" + filename, "/", "\\");
+    #else
+        const std::string filepath = m_path + m_rd_name + "/" + filename;
+    #endif
+
+    // Create the OpenPMD series
+    auto series = io::Series(
+            filepath,
+            io::Access::CREATE);
+    auto i = series.iterations[step + 1];
+
+    // Get time at level 0
+    auto & warpx = WarpX::GetInstance();
+    auto const time = warpx.gett_new(0);
+    i.setTime(time);
+
+    // one mesh per histogram, whose axes are stored from the slowest to the fastest varying
+    for (auto const& hist : m_histograms) {
+        auto f_mesh = i.meshes[hist.name];
+        std::vector<std::string> axis_labels;
+        std::vector<double> grid_global_offset;
+        std::vector<amrex::Real> grid_spacing;
+        std::vector<amrex::Real> position;
+        io::Extent extent;
+        for (auto axis = hist.axes.rbegin(); axis != hist.axes.rend(); ++axis) {
+            f_mesh.setAttribute("function_" + axis->name, axis->function_string);
+            axis_labels.push_back(axis->name);
+            grid_global_offset.push_back(axis->bin_min);
+            grid_spacing.push_back(axis->bin_size);
+            position.push_back(0.5_rt);
+            extent.push_back(static_cast<std::uint64_t>(axis->bin_num));
+        }
+        f_mesh.setAttribute("value", hist.value_string);
+        f_mesh.setAttribute("filter", hist.filter_string);
+        f_mesh.setAxisLabels(axis_labels);
+        f_mesh.setGridGlobalOffset(grid_global_offset);
+        f_mesh.setGridSpacing<amrex::Real>(grid_spacing);
+
+        // record components
+        auto data = f_mesh[io::RecordComponent::SCALAR];
+        data.setPosition<amrex::Real>(position);
+
+        // UNIT DIMENSION IS NOT SET ON THE VALUES
+
+        data.resetDataset(io::Dataset(io::determineDatatype<amrex::Real>(), extent));
+        data.storeChunkRaw(m_h_data.data() + hist.offset, io::Offset(extent.size(), 0), extent);
+    }
+
+    series.flush();
+    i.close();
+    series.close();
+#else
+    amrex::ignore_unused(step);
+    WARPX_ABORT_WITH_MESSAGE("ParticleHistogramND: Needs openPMD-api compiled into WarpX, but was not found!");
+#endif
+}
@@ -16,6 +16,7 @@
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_ParticleReduce.H>
 #include <AMReX_Particles.H>
 #include <AMReX_REAL.H>
@@ -47,6 +48,12 @@ ParticleMomentum::ParticleMomentum (const std::string& rd_name)
     // Resize data array
     m_data.resize(6*nSpecies+6, 0.0_rt);
 
+    // Read whether the moments accumulated during the particle push are used
+    const ParmParse pp_rd("reduced_diags");
+    const ParmParse pp_rd_name(rd_name);
+    pp_rd.query("fuse_with_push", m_use_push_moments);
+    pp_rd_name.query("fuse_with_push", m_use_push_moments);
+
     // Get species names
     const std::vector<std::string> species_names = mypc.GetSpeciesNames();
 
@@ -118,12 +125,19 @@ void ParticleMomentum::ComputeDiags (int step)
     // Check if the diags should be done
     if (!m_intervals.contains(step+1)) { return; }
 
+    // Get a reference to WarpX instance
+    auto & warpx = WarpX::GetInstance();
+
     // Get MultiParticleContainer class object
-    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+    const auto & mypc = warpx.GetPartContainer();
 
     // Get number of species
     const int nSpecies = mypc.nSpecies();
 
+    // The moments accumulated during the push are those of the particles at p^{n+1/2}:
+    // they are not used when the momenta were synchronized with the positions after the push
+    const bool synchronized = warpx.getis_synchronized();
+
     amrex::Real Wtot = 0.0_rt;
 
     // Loop over species
@@ -139,26 +153,43 @@ void ParticleMomentum::ComputeDiags (int step)
 
         using PType = typename WarpXParticleContainer::SuperParticleType;
 
-        // Use amrex::ParticleReduce to compute the sum of the momenta and weights of all particles
-        // held by the current MPI rank for this species (loop over all boxes held by this MPI rank):
-        // the result r is the tuple (Px, Py, Pz, Ws)
-        amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_ops;
-        auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real, Real, Real>>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real, Real, Real>
-            {
-                const amrex::Real w  = p.rdata(PIdx::w);
-                const amrex::Real ux = p.rdata(PIdx::ux);
-                const amrex::Real uy = p.rdata(PIdx::uy);
-                const amrex::Real uz = p.rdata(PIdx::uz);
-                return {w*m*ux, w*m*uy, w*m*uz, w};
-            },
-            reduce_ops);
-
-        amrex::Real Px = amrex::get<0>(r);
-        amrex::Real Py = amrex::get<1>(r);
-        amrex::Real Pz = amrex::get<2>(r);
-        amrex::Real Ws = amrex::get<3>(r);
+        amrex::Real Px = 0.0_rt;
+        amrex::Real Py = 0.0_rt;
+        amrex::Real Pz = 0.0_rt;
+        amrex::Real Ws = 0.0_rt;
+
+        if (m_use_push_moments && myspc.accumulatePushMoments() && !synchronized)
+        {
+            // Sums already accumulated during the particle push
+            auto const moments = myspc.GetPushMoments();
+            Px = m*moments[PushMomentIdx::ux];
+            Py = m*moments[PushMomentIdx::uy];
+            Pz = m*moments[PushMomentIdx::uz];
+            Ws = moments[PushMomentIdx::w];
+        }
+        else
+        {
+            // Use amrex::ParticleReduce to compute the sum of the momenta and weights of all particles
+            // held by the current MPI rank for this species (loop over all boxes held by this MPI rank):
+            // the result r is the tuple (Px, Py, Pz, Ws)
+            amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_ops;
+            auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real, Real, Real>>(
+                myspc,
+                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real, Real, Real>
+                {
+                    const amrex::Real w  = p.rdata(PIdx::w);
+                    const amrex::Real ux = p.rdata(PIdx::ux);
+                    const amrex::Real uy = p.rdata(PIdx::uy);
+                    const amrex::Real uz = p.rdata(PIdx::uz);
+                    return {w*m*ux, w*m*uy, w*m*uz, w};
+                },
+                reduce_ops);
+
+            Px = amrex::get<0>(r);
+            Py = amrex::get<1>(r);
+            Pz = amrex::get<2>(r);
+            Ws = amrex::get<3>(r);
+        }
 
         // Reduced sum over MPI ranks
         ParallelDescriptor::ReduceRealSum({Px,Py,Pz,Ws}, ParallelDescriptor::IOProcessorNumber());
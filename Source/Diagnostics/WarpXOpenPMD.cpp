@@ -28,6 +28,8 @@
 #include <AMReX_DataAllocator.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
@@ -38,18 +40,27 @@
 #include <AMReX_Particle.H>
 #include <AMReX_Particles.H>
 #include <AMReX_Periodicity.H>
+#include <AMReX_Random.H>
+#include <AMReX_Scan.H>
 #include <AMReX_StructOfArrays.H>
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <regex>
 #include <set>
+#include <sstream>
 #include <string>
+#include <system_error>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace detail
@@ -99,7 +110,7 @@ namespace detail
                       std::string const & engine_type,
                       std::map< std::string, std::string > const & engine_parameters)
     {
-        if (operator_type.empty() && engine_type.empty()) {
+        if (operator_type.empty() && engine_type.empty() && engine_parameters.empty()) {
             return "{}";
         }
 
@@ -368,6 +379,155 @@ namespace detail
                                   });
         }
     }
+
+    /** \brief Select the particles of a container for output, by tile.
+     *
+     * For each tile, the filter is evaluated once per particle, and the index of each
+     * selected particle among the selected particles of the tile is stored.
+     *
+     * @param[in] pc the particle container
+     * @param[in] filter functor returning whether a particle is selected
+     * @param[in] do_filter whether to apply the filter (if false, all the particles are selected)
+     * @return the selection
+     */
+    template <typename PC, typename F>
+    ParticleSelection
+    selectParticles (PC& pc, F const& filter, bool const do_filter)
+    {
+        ParticleSelection selection;
+        selection.tiles.resize(pc.finestLevel()+1);
+        for (int lev = 0; lev <= pc.finestLevel(); ++lev) {
+            for (typename PC::ParConstIterType pti(pc, lev); pti.isValid(); ++pti) {
+                auto& tile_selection = selection.tiles[lev][std::make_pair(pti.index(), pti.LocalTileIndex())];
+                auto const np = static_cast<int>(pti.numParticles());
+                if (!do_filter || np == 0) {
+                    tile_selection.num_selected = np;
+                    continue;
+                }
+                // The mask has an extra (zero) element, such that its exclusive sum
+                // also gives the number of selected particles
+                amrex::Gpu::DeviceVector<int> mask(np+1);
+                tile_selection.dst_index.resize(np+1);
+                int* const mask_ptr = mask.data();
+                auto const ptd = pti.GetParticleTile().getConstParticleTileData();
+                amrex::ParallelForRNG(np+1,
+                    [=] AMREX_GPU_DEVICE (int ip, amrex::RandomEngine const& engine) noexcept
+                    {
+                        mask_ptr[ip] = (ip < np) ? static_cast<int>(filter(ptd, ip, engine)) : 0;
+                    });
+                tile_selection.num_selected = amrex::Scan::ExclusiveSum(
+                    np+1, mask_ptr, tile_selection.dst_index.data(), amrex::Scan::retSum);
+            }
+        }
+        return selection;
+    }
+
+    /** Value of a particle component */
+    template <typename T>
+    struct ComponentValue
+    {
+        T const* m_data;
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        T operator() (int ip) const noexcept { return m_data[ip]; }
+    };
+
+#if defined(WARPX_DIM_RZ)
+    /** Cartesian position (x for dir = 0, y for dir = 1) of a particle, from r and theta */
+    struct CartesianPositionValue
+    {
+        amrex::ParticleReal const* m_r;
+        amrex::ParticleReal const* m_theta;
+        int m_dir;
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        amrex::ParticleReal operator() (int ip) const noexcept
+        {
+            return m_r[ip]*((m_dir == 0) ? std::cos(m_theta[ip]) : std::sin(m_theta[ip]));
+        }
+    };
+#endif
+
+    /** \brief Store the values of the selected particles of a tile in a record component.
+     *
+     * The values are compacted directly into the buffer of the openPMD backend, obtained
+     * with the span-based storeChunk. On GPU, they are compacted into a staging buffer
+     * of the size of the tile, which is then copied into the buffer of the backend.
+     *
+     * @param[in] comp the record component
+     * @param[in] offset offset of the first selected particle of the tile in the record
+     * @param[in] np number of particles in the tile
+     * @param[in] tile_selection the selected particles of the tile
+     * @param[in] value functor returning the value of a particle
+     */
+    template <typename T, typename F>
+    void
+    storeSelected (openPMD::RecordComponent comp, uint64_t const offset, int const np,
+                   ParticleSelection::Tile const& tile_selection, F const& value)
+    {
+        auto const num_selected = tile_selection.num_selected;
+        auto span = comp.storeChunk<T>({offset}, {static_cast<uint64_t>(num_selected)});
+        int const* const dst_index = tile_selection.dst_index.empty() ?
+            nullptr : tile_selection.dst_index.data();
+#ifdef AMREX_USE_GPU
+        amrex::Gpu::DeviceVector<T> staging(num_selected);
+        T* const out = staging.data();
+#else
+        T* const out = span.currentBuffer().data();
+#endif
+        amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int ip) noexcept
+        {
+            if (dst_index == nullptr) {
+                out[ip] = value(ip);
+            } else if (dst_index[ip+1] > dst_index[ip]) {
+                out[dst_index[ip]] = value(ip);
+            }
+        });
+#ifdef AMREX_USE_GPU
+        amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost, staging.begin(), staging.end(),
+                              span.currentBuffer().data());
+        amrex::Gpu::streamSynchronize();
+#endif
+    }
+
+    /** \brief Store a component of the selected particles of a tile in a record component.
+     *
+     * If all the particles of the tile are selected and the data is accessible on the
+     * host, the data is passed to the backend without copy (it must then remain valid
+     * until the next flush of the series).
+     */
+    template <typename T>
+    void
+    storeComponent (openPMD::RecordComponent comp, uint64_t const offset, int const np,
+                    ParticleSelection::Tile const& tile_selection, bool const host_accessible,
+                    T const* data)
+    {
+        if (host_accessible && tile_selection.dst_index.empty()) {
+            comp.storeChunkRaw(data, {offset}, {static_cast<uint64_t>(np)});
+        } else {
+            storeSelected<T>(comp, offset, np, tile_selection, ComponentValue<T>{data});
+        }
+    }
+
+    /** \brief Total size of the regular files in a directory and its subdirectories
+     *
+     * @param[in] path the directory
+     * @return the size in bytes (0 if the directory does not exist)
+     */
+    std::uintmax_t
+    getDirectorySize (std::string const& path)
+    {
+        std::error_code ec;
+        std::uintmax_t size = 0;
+        if (!std::filesystem::is_directory(path, ec)) { return size; }
+        for (auto const& entry : std::filesystem::recursive_directory_iterator(path, ec)) {
+            if (entry.is_regular_file(ec)) {
+                auto const file_size = entry.file_size(ec);
+                if (!ec) { size += file_size; }
+            }
+        }
+        return size;
+    }
 #endif // WARPX_USE_OPENPMD
 } // namespace detail
 
@@ -380,14 +540,20 @@ WarpXOpenPMDPlot::WarpXOpenPMDPlot (
     const std::string& engine_type,
     const std::map< std::string, std::string >& engine_parameters,
     const std::vector<bool>& fieldPMLdirections,
-    const std::string& authors)
+    const std::string& authors,
+    const bool async_write,
+    const std::string& lossy_operator_type,
+    const std::map< std::string, FieldErrorBound >& field_error_bounds)
     : m_Series(nullptr),
       m_MPIRank{amrex::ParallelDescriptor::MyProc()},
       m_MPISize{amrex::ParallelDescriptor::NProcs()},
       m_Encoding(ie),
       m_OpenPMDFileType{openPMDFileType},
       m_fieldPMLdirections{fieldPMLdirections},
-      m_authors{authors}
+      m_authors{authors},
+      m_async_write{async_write},
+      m_lossy_operator_type{lossy_operator_type},
+      m_field_error_bounds{field_error_bounds}
 {
     m_OpenPMDoptions = detail::getSeriesOptions(operator_type, operator_parameters,
                                                 engine_type, engine_parameters);
@@ -444,9 +610,27 @@ void WarpXOpenPMDPlot::SetStep (int ts, const std::string& dirPrefix, int file_m
     }
 
     m_CurrentStep = ts;
+
+    if (!m_lossy_operator_type.empty()) {
+        m_compression_report.clear();
+        m_compression_raw_bytes = 0;
+        if (!isBTD && !m_async_write && amrex::ParallelDescriptor::IOProcessor()) {
+            m_dir_size_at_step_start = detail::getDirectorySize(m_dirPrefix);
+        }
+    }
+
     Init(openPMD::Access::CREATE, isBTD);
 }
 
+void WarpXOpenPMDPlot::FlushSeries (bool isBTD) const
+{
+    if (m_async_write && !isBTD) {
+        m_Series->flush(R"({"adios2": {"engine": {"preferred_flush_target": "buffer"}}})");
+    } else {
+        m_Series->flush();
+    }
+}
+
 void WarpXOpenPMDPlot::CloseStep (bool isBTD, bool isLastBTDFlush)
 {
     // default close is true
@@ -469,6 +653,41 @@ void WarpXOpenPMDPlot::CloseStep (bool isBTD, bool isLastBTDFlush)
             pv_helper_file << filename << "\n";
             pv_helper_file.close();
         }
+
+        if (!isBTD && !m_lossy_operator_type.empty()) { WriteCompressionReport(); }
+    }
+}
+
+void WarpXOpenPMDPlot::WriteCompressionReport ()
+{
+    if (m_compression_report.empty() || !amrex::ParallelDescriptor::IOProcessor()) { return; }
+
+    std::string const report_name = m_dirPrefix + "/compression_report.txt";
+    std::error_code ec;
+    bool const write_header = !std::filesystem::exists(report_name, ec);
+    std::ofstream report(report_name, std::ofstream::app);
+    if (write_header) {
+        report << "# step field abs_error_bound max_abs_value raw_bytes\n"
+               << "# step total raw_bytes written_bytes compression_ratio\n";
+    }
+    for (auto const& line : m_compression_report) {
+        report << line << "\n";
+    }
+    report << m_CurrentStep << " total " << m_compression_raw_bytes;
+    if (m_async_write) {
+        // the step is still being written in the background
+        report << " n/a n/a\n";
+    } else {
+        std::uintmax_t const dir_size = detail::getDirectorySize(m_dirPrefix);
+        std::uintmax_t const written_bytes =
+            dir_size > m_dir_size_at_step_start ? dir_size - m_dir_size_at_step_start : 0;
+        report << " " << written_bytes << " ";
+        if (written_bytes > 0) {
+            report << std::setprecision(4)
+                   << static_cast<double>(m_compression_raw_bytes) / static_cast<double>(written_bytes) << "\n";
+        } else {
+            report << "n/a\n";
+        }
     }
 }
 
@@ -541,10 +760,6 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
         }
     }
 
-    PinnedMemoryParticleContainer tmp = (isBTD || use_pinned_pc) ?
-        pinned_pc->make_alike<amrex::PinnedArenaAllocator>() :
-        pc->make_alike<amrex::PinnedArenaAllocator>();
-
     const auto mass = pc->AmIA<PhysicalSpecies::photon>() ? PhysConst::m_e : pc->getMass();
     RandomFilter const random_filter(particle_diags[i].m_do_random_filter,
                                      particle_diags[i].m_random_fraction);
@@ -557,95 +772,109 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
     parser_filter.m_units = InputUnits::SI;
     GeometryFilter const geometry_filter(particle_diags[i].m_do_geom_filter,
                                            particle_diags[i].m_diag_domain);
+    bool const do_filter = particle_diags[i].m_do_random_filter || particle_diags[i].m_do_uniform_filter ||
+                           particle_diags[i].m_do_parser_filter || particle_diags[i].m_do_geom_filter;
+    using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
+    auto const particle_filter = [random_filter,uniform_filter,parser_filter,geometry_filter]
+        AMREX_GPU_HOST_DEVICE
+        (const SrcData& src, int ip, const amrex::RandomEngine& engine)
+        {
+            const SuperParticleType& p = src.getSuperParticle(ip);
+            return random_filter(p, engine) * uniform_filter(p, engine)
+                    * parser_filter(p, engine) * geometry_filter(p, engine);
+        };
 
-    if (isBTD || use_pinned_pc) {
+    // Write the selected particles of a container, whose data is in SI units
+    auto const write_particles = [&] (auto* out_pc, ParticleSelection const& selection)
+    {
+        // names of amrex::Real and int particle attributes in SoA data
+        amrex::Vector<std::string> real_names;
+        amrex::Vector<std::string> int_names;
+        amrex::Vector<int> int_flags;
+        amrex::Vector<int> real_flags;
+        // see openPMD ED-PIC extension for namings
+        // note: an underscore separates the record name from its component
+        //       for non-scalar records
+        // note: in RZ, we reconstruct x,y,z positions from r,z,theta in WarpX
+#if !defined (WARPX_DIM_1D_Z)
+        real_names.push_back("position_x");
+#endif
+#if defined (WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
+        real_names.push_back("position_y");
+#endif
+        real_names.push_back("position_z");
+        real_names.push_back("weighting");
+        real_names.push_back("momentum_x");
+        real_names.push_back("momentum_y");
+        real_names.push_back("momentum_z");
+        // get the names of the real comps
+        real_names.resize(out_pc->NumRealComps());
+        auto runtime_rnames = out_pc->getParticleRuntimeComps();
+        for (auto const& x : runtime_rnames)
+        {
+            real_names[x.second+PIdx::nattribs] = detail::snakeToCamel(x.first);
+        }
+        // plot any "extra" fields by default
+        real_flags = particle_diags[i].m_plot_flags;
+        real_flags.resize(out_pc->NumRealComps(), 1);
+        // and the names
+        int_names.resize(out_pc->NumIntComps());
+        auto runtime_inames = out_pc->getParticleRuntimeiComps();
+        for (auto const& x : runtime_inames)
+        {
+            int_names[x.second+0] = detail::snakeToCamel(x.first);
+        }
+        // plot by default
+        int_flags.resize(out_pc->NumIntComps(), 1);
+
+        // real_names contains a list of all real particle attributes.
+        // real_flags is 1 or 0, whether quantity is dumped or not.
+        DumpToFile(out_pc, selection,
+            particle_diags.at(i).getSpeciesName(),
+            m_CurrentStep,
+            real_flags,
+            int_flags,
+            real_names, int_names,
+            pc->getCharge(), pc->getMass(),
+            isBTD, isLastBTDFlush);
+    };
+
+    if ( particle_diags[i].m_plot_phi ) {
+        // The electrostatic potential is gathered on a temporary copy of the selected particles
+        PinnedMemoryParticleContainer tmp = (isBTD || use_pinned_pc) ?
+            pinned_pc->make_alike<amrex::PinnedArenaAllocator>() :
+            pc->make_alike<amrex::PinnedArenaAllocator>();
+        if (isBTD || use_pinned_pc) {
+            particlesConvertUnits(ConvertDirection::WarpX_to_SI, pinned_pc, mass);
+            tmp.copyParticles(*pinned_pc, particle_filter, true);
+            particlesConvertUnits(ConvertDirection::SI_to_WarpX, pinned_pc, mass);
+        } else {
+            particlesConvertUnits(ConvertDirection::WarpX_to_SI, pc, mass);
+            tmp.copyParticles(*pc, particle_filter, true);
+            particlesConvertUnits(ConvertDirection::SI_to_WarpX, pc, mass);
+        }
+
+        storePhiOnParticles( tmp, WarpX::electrostatic_solver_id, !use_pinned_pc );
+
+        write_particles(&tmp, detail::selectParticles(tmp, particle_filter, false));
+    } else if (isBTD || use_pinned_pc) {
+        // The selected particles are written directly from the container, whose
+        // units are converted back after the data has been passed to the backend
         particlesConvertUnits(ConvertDirection::WarpX_to_SI, pinned_pc, mass);
-        using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
-        tmp.copyParticles(*pinned_pc,
-            [random_filter,uniform_filter,parser_filter,geometry_filter]
-            AMREX_GPU_HOST_DEVICE
-            (const SrcData& src, int ip, const amrex::RandomEngine& engine)
-            {
-                const SuperParticleType& p = src.getSuperParticle(ip);
-                return random_filter(p, engine) * uniform_filter(p, engine)
-                        * parser_filter(p, engine) * geometry_filter(p, engine);
-            }, true);
+        write_particles(pinned_pc, detail::selectParticles(*pinned_pc, particle_filter, do_filter));
         particlesConvertUnits(ConvertDirection::SI_to_WarpX, pinned_pc, mass);
     } else {
         particlesConvertUnits(ConvertDirection::WarpX_to_SI, pc, mass);
-        using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
-        tmp.copyParticles(*pc,
-            [random_filter,uniform_filter,parser_filter,geometry_filter]
-            AMREX_GPU_HOST_DEVICE
-            (const SrcData& src, int ip, const amrex::RandomEngine& engine)
-            {
-                const SuperParticleType& p = src.getSuperParticle(ip);
-                return random_filter(p, engine) * uniform_filter(p, engine)
-                        * parser_filter(p, engine) * geometry_filter(p, engine);
-            }, true);
+        write_particles(pc, detail::selectParticles(*pc, particle_filter, do_filter));
         particlesConvertUnits(ConvertDirection::SI_to_WarpX, pc, mass);
     }
-
-    // Gather the electrostatic potential (phi) on the macroparticles
-    if ( particle_diags[i].m_plot_phi ) {
-        storePhiOnParticles( tmp, WarpX::electrostatic_solver_id, !use_pinned_pc );
-    }
-
-    // names of amrex::Real and int particle attributes in SoA data
-    amrex::Vector<std::string> real_names;
-    amrex::Vector<std::string> int_names;
-    amrex::Vector<int> int_flags;
-    amrex::Vector<int> real_flags;
-    // see openPMD ED-PIC extension for namings
-    // note: an underscore separates the record name from its component
-    //       for non-scalar records
-    // note: in RZ, we reconstruct x,y,z positions from r,z,theta in WarpX
-#if !defined (WARPX_DIM_1D_Z)
-    real_names.push_back("position_x");
-#endif
-#if defined (WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-    real_names.push_back("position_y");
-#endif
-    real_names.push_back("position_z");
-    real_names.push_back("weighting");
-    real_names.push_back("momentum_x");
-    real_names.push_back("momentum_y");
-    real_names.push_back("momentum_z");
-    // get the names of the real comps
-    real_names.resize(tmp.NumRealComps());
-    auto runtime_rnames = tmp.getParticleRuntimeComps();
-    for (auto const& x : runtime_rnames)
-    {
-        real_names[x.second+PIdx::nattribs] = detail::snakeToCamel(x.first);
-    }
-    // plot any "extra" fields by default
-    real_flags = particle_diags[i].m_plot_flags;
-    real_flags.resize(tmp.NumRealComps(), 1);
-    // and the names
-    int_names.resize(tmp.NumIntComps());
-    auto runtime_inames = tmp.getParticleRuntimeiComps();
-    for (auto const& x : runtime_inames)
-    {
-        int_names[x.second+0] = detail::snakeToCamel(x.first);
-    }
-    // plot by default
-    int_flags.resize(tmp.NumIntComps(), 1);
-
-    // real_names contains a list of all real particle attributes.
-    // real_flags is 1 or 0, whether quantity is dumped or not.
-    DumpToFile(&tmp,
-        particle_diags.at(i).getSpeciesName(),
-        m_CurrentStep,
-        real_flags,
-        int_flags,
-        real_names, int_names,
-        pc->getCharge(), pc->getMass(),
-        isBTD, isLastBTDFlush);
     }
 }
 
+template <typename PC>
 void
-WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
+WarpXOpenPMDPlot::DumpToFile (PC* pc,
+                    ParticleSelection const& selection,
                     const std::string& name,
                     int iteration,
                     const amrex::Vector<int>& write_real_comp,
@@ -665,9 +894,16 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
     AMREX_ALWAYS_ASSERT(real_comp_names.size() == pc->NumRealComps());
     AMREX_ALWAYS_ASSERT(int_comp_names.size() == pc->NumIntComps());
 
-    WarpXParticleCounter counter(pc);
+    WarpXParticleCounter counter(selection);
     auto const num_dump_particles = counter.GetTotalNumParticles();
 
+#ifdef AMREX_USE_GPU
+    // the data of containers in pinned memory can be read directly by the backend
+    constexpr bool host_accessible = std::is_base_of_v<ParticleContainer, PC>;
+#else
+    constexpr bool host_accessible = true;
+#endif
+
     openPMD::Iteration currIteration = GetIteration(iteration, isBTD);
     openPMD::ParticleSpecies currSpecies = currIteration.particles[name];
 
@@ -708,7 +944,7 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
     //   for BTD, we call this multiple times as we may resize in subsequent dumps if number of particles in the buffer > 0
     if (doParticleSetup || is_resizing_flush) {
         SetupPos(currSpecies, positionComponents, NewParticleVectorSize, isBTD);
-        SetupRealProperties(pc, currSpecies, write_real_comp, real_comp_names, write_int_comp, int_comp_names,
+        SetupRealProperties(currSpecies, write_real_comp, real_comp_names, write_int_comp, int_comp_names,
                             NewParticleVectorSize, isBTD);
     }
 
@@ -717,7 +953,7 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
     }
 
     // open files from all processors, in case some will not contribute below
-    m_Series->flush();
+    FlushSeries(isBTD);
 
     // dump individual particles
     bool contributed_particles = false;  // did the local MPI rank contribute particles?
@@ -725,25 +961,28 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
         auto offset = static_cast<uint64_t>( counter.m_ParticleOffsetAtRank[currentLevel] );
         // For BTD, the offset include the number of particles already flushed
         if (isBTD) { offset += ParticleFlushOffset; }
-        for (ParticleIter pti(*pc, currentLevel); pti.isValid(); ++pti) {
-            auto const numParticleOnTile = pti.numParticles();
-            auto const numParticleOnTile64 = static_cast<uint64_t>( numParticleOnTile );
+        for (typename PC::ParConstIterType pti(*pc, currentLevel); pti.isValid(); ++pti) {
+            auto const& tile_selection =
+                selection.tiles[currentLevel].at(std::make_pair(pti.index(), pti.LocalTileIndex()));
+            auto const numSelectedOnTile64 = static_cast<uint64_t>( tile_selection.num_selected );
 
             // Do not call storeChunk() with zero-sized particle tiles:
             //   https://github.com/openPMD/openPMD-api/issues/1147
             //   https://github.com/ECP-WarpX/WarpX/pull/1898#discussion_r745008290
-            if (numParticleOnTile == 0) { continue; }
+            if (tile_selection.num_selected == 0) { continue; }
 
             contributed_particles = true;
 
             //  save particle properties
             SaveRealProperty(pti,
+                             tile_selection,
+                             host_accessible,
                              currSpecies,
                              offset,
                              write_real_comp, real_comp_names,
                              write_int_comp, int_comp_names);
 
-            offset += numParticleOnTile64;
+            offset += numSelectedOnTile64;
         } // pti
     } // currentLevel
 
@@ -797,12 +1036,11 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
         }
     }
 
-    m_Series->flush();
+    FlushSeries(isBTD);
 }
 
 void
-WarpXOpenPMDPlot::SetupRealProperties (ParticleContainer const * pc,
-                      openPMD::ParticleSpecies& currSpecies,
+WarpXOpenPMDPlot::SetupRealProperties (openPMD::ParticleSpecies& currSpecies,
                       const amrex::Vector<int>& write_real_comp,
                       const amrex::Vector<std::string>& real_comp_names,
                       const amrex::Vector<int>& write_int_comp,
@@ -836,7 +1074,7 @@ WarpXOpenPMDPlot::SetupRealProperties (ParticleContainer const * pc,
     }
 
     std::set< std::string > addedRecords; // add meta-data per record only once
-    for (auto idx=0; idx<pc->NumRealComps(); idx++) {
+    for (auto idx=0; idx<real_counter; idx++) {
         if (write_real_comp[idx]) {
             // handle scalar and non-scalar records by name
             const auto [record_name, component_name] = detail::name2openPMD(real_comp_names[idx]);
@@ -880,8 +1118,11 @@ WarpXOpenPMDPlot::SetupRealProperties (ParticleContainer const * pc,
     }
 }
 
+template <typename PIter>
 void
-WarpXOpenPMDPlot::SaveRealProperty (ParticleIter& pti,
+WarpXOpenPMDPlot::SaveRealProperty (PIter& pti,
+                       ParticleSelection::Tile const& tile_selection,
+                       bool const host_accessible,
                        openPMD::ParticleSpecies& currSpecies,
                        unsigned long long const offset,
                        amrex::Vector<int> const& write_real_comp,
@@ -890,8 +1131,7 @@ WarpXOpenPMDPlot::SaveRealProperty (ParticleIter& pti,
                        amrex::Vector<std::string> const& int_comp_names) const
 
 {
-    auto const numParticleOnTile = pti.numParticles();
-    auto const numParticleOnTile64 = static_cast<uint64_t>(numParticleOnTile);
+    auto const numParticleOnTile = static_cast<int>(pti.numParticles());
     auto const& soa = pti.GetStructOfArrays();
 
     auto const getComponentRecord = [&currSpecies](std::string const& comp_name) {
@@ -903,8 +1143,8 @@ WarpXOpenPMDPlot::SaveRealProperty (ParticleIter& pti,
     // here we the save the SoA properties (idcpu)
     {
         // todo: add support to not write the particle index
-        getComponentRecord("id").storeChunkRaw(
-            soa.GetIdCPUData().data(), {offset}, {numParticleOnTile64});
+        detail::storeComponent(getComponentRecord("id"), offset, numParticleOnTile,
+                               tile_selection, host_accessible, soa.GetIdCPUData().data());
     }
 
     // here we the save the SoA properties (real)
@@ -914,31 +1154,13 @@ WarpXOpenPMDPlot::SaveRealProperty (ParticleIter& pti,
 #if defined(WARPX_DIM_RZ)
         // reconstruct Cartesian positions for RZ simulations
         // r,z,theta -> x,y,z
-        // If each comp is being written, create a temporary array, otherwise create an empty array.
-        std::shared_ptr<amrex::ParticleReal> const x(
-            new amrex::ParticleReal[(write_real_comp[0] ? numParticleOnTile : 0)],
-            [](amrex::ParticleReal const *p) { delete[] p; }
-        );
-        std::shared_ptr<amrex::ParticleReal> const y(
-            new amrex::ParticleReal[(write_real_comp[1] ? numParticleOnTile : 0)],
-            [](amrex::ParticleReal const *p) { delete[] p; }
-        );
-
-        const auto& tile = pti.GetParticleTile();
-        const auto& ptd = tile.getConstParticleTileData();
-
-        for (int i = 0; i < numParticleOnTile; ++i) {
-            const auto& p = ptd.getSuperParticle(i);
-            amrex::ParticleReal xp, yp, zp;
-            get_particle_position(p, xp, yp, zp);
-            if (write_real_comp[0]) { x.get()[i] = xp; }
-            if (write_real_comp[1]) { y.get()[i] = yp; }
-        }
-        if (write_real_comp[0]) {
-            getComponentRecord(real_comp_names[0]).storeChunk(x, {offset}, {numParticleOnTile64});
-        }
-        if (write_real_comp[1]) {
-            getComponentRecord(real_comp_names[1]).storeChunk(y, {offset}, {numParticleOnTile64});
+        for (int dir = 0; dir < 2; ++dir) {
+            if (write_real_comp[dir]) {
+                detail::storeSelected<amrex::ParticleReal>(
+                    getComponentRecord(real_comp_names[dir]), offset, numParticleOnTile, tile_selection,
+                    detail::CartesianPositionValue{soa.GetRealData(PIdx::x).data(),
+                                                   soa.GetRealData(PIdx::theta).data(), dir});
+            }
         }
 #endif
 
@@ -957,8 +1179,8 @@ WarpXOpenPMDPlot::SaveRealProperty (ParticleIter& pti,
             int const soa_r_idx = idx;
 #endif
             if (write_real_comp[idx]) {
-                getComponentRecord(real_comp_names[idx]).storeChunkRaw(
-                    soa.GetRealData(soa_r_idx).data(), {offset}, {numParticleOnTile64});
+                detail::storeComponent(getComponentRecord(real_comp_names[idx]), offset, numParticleOnTile,
+                                       tile_selection, host_accessible, soa.GetRealData(soa_r_idx).data());
             }
         }
     }
@@ -967,8 +1189,8 @@ WarpXOpenPMDPlot::SaveRealProperty (ParticleIter& pti,
         auto const int_counter = std::min(write_int_comp.size(), int_comp_names.size());
         for (auto idx=0; idx<int_counter; idx++) {
             if (write_int_comp[idx]) {
-                getComponentRecord(int_comp_names[idx]).storeChunkRaw(
-                    soa.GetIntData(idx).data(), {offset}, {numParticleOnTile64});
+                detail::storeComponent(getComponentRecord(int_comp_names[idx]), offset, numParticleOnTile,
+                                       tile_selection, host_accessible, soa.GetIntData(idx).data());
             }
         }
     }
@@ -1212,7 +1434,8 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
                                  std::string const& comp_name,
                                  std::string const& field_name,
                                  amrex::MultiFab const& mf,
-                                 bool var_in_theta_mode) const
+                                 bool var_in_theta_mode,
+                                 std::string const& dataset_options) const
 {
     auto mesh_comp = mesh[comp_name];
     amrex::Box const & global_box = full_geom.Domain();
@@ -1231,7 +1454,7 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
 
     // Prepare the type of dataset that will be written
     openPMD::Datatype const datatype = openPMD::determineDatatype<amrex::Real>();
-    auto const dataset = openPMD::Dataset(datatype, global_size);
+    auto const dataset = openPMD::Dataset(datatype, global_size, dataset_options);
     mesh.setDataOrder(openPMD::Mesh::DataOrder::C);
     if (var_in_theta_mode) {
         mesh.setGeometry("thetaMode");
@@ -1324,6 +1547,51 @@ GetFieldNameModeInt (const std::string& varname)
     }
 }
 
+std::string
+WarpXOpenPMDPlot::GetLossyDatasetOptions (std::string const& field_name,
+                                          amrex::MultiFab const& mf,
+                                          std::vector<std::string> const& varnames,
+                                          std::string const& report_name) const
+{
+    auto const bound = m_field_error_bounds.find(field_name);
+    if (m_lossy_operator_type.empty() || bound == m_field_error_bounds.end()) { return "{}"; }
+
+    // maximum over all the components of the field (several modes in RZ)
+    amrex::Real max_abs = 0;
+    int ncomp_field = 0;
+    for (int icomp = 0; icomp < mf.nComp(); icomp++) {
+        if (std::get<0>(GetFieldNameModeInt(varnames[icomp])) == field_name) {
+            max_abs = std::max(max_abs, mf.norm0(icomp));
+            ncomp_field++;
+        }
+    }
+
+    amrex::Real const abs_error = bound->second.is_relative ?
+        bound->second.value * max_abs : bound->second.value;
+    // e.g. relative error bound of a field that is zero everywhere
+    if (abs_error <= 0) { return "{}"; }
+
+    // The compressed values differ from the original ones by at most the accuracy.
+    // MGARD bounds the error in the L2 norm by default: the L-infinity norm and
+    // the absolute mode are selected so that the bound is also point-wise.
+    std::stringstream options;
+    options << std::setprecision(17)
+            << R"({"adios2": {"dataset": {"operators": [{"type": ")" << m_lossy_operator_type
+            << R"(", "parameters": {"accuracy": ")" << abs_error << R"(")";
+    if (m_lossy_operator_type == "mgard") {
+        options << R"(, "s": "inf", "mode": "ABS")";
+    }
+    options << R"(}}]}}})";
+
+    std::stringstream line;
+    line << m_CurrentStep << " " << report_name << " " << std::setprecision(6)
+         << abs_error << " " << max_abs << " "
+         << mf.boxArray().numPts() * ncomp_field * static_cast<amrex::Long>(sizeof(amrex::Real));
+    m_compression_report.push_back(line.str());
+
+    return options.str();
+}
+
 /** Write Field with all mesh levels
  *
  */
@@ -1379,6 +1647,9 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
         amrex::Box const & global_box = full_geom.Domain();
 
         int const ncomp = mf[lev].nComp();
+        if (!m_lossy_operator_type.empty()) {
+            m_compression_raw_bytes += mf[lev].boxArray().numPts() * ncomp * sizeof(amrex::Real);
+        }
         for ( int icomp=0; icomp<ncomp; icomp++ ) {
             std::string const & varname = varnames[icomp];
 
@@ -1398,7 +1669,9 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                                         comp_name,
                                         field_name,
                                         mf[lev],
-                                        var_in_theta_mode );
+                                        var_in_theta_mode,
+                                        GetLossyDatasetOptions(varname_no_mode, mf[lev], varnames,
+                                                               field_name) );
                     }
                 } else {
                     auto mesh = meshes[field_name];
@@ -1408,7 +1681,9 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                                         comp_name,
                                         field_name,
                                         mf[lev],
-                                        var_in_theta_mode );
+                                        var_in_theta_mode,
+                                        GetLossyDatasetOptions(varname_no_mode, mf[lev], varnames,
+                                                               field_name + "/" + comp_name) );
                     }
                 }
             }
@@ -1469,7 +1744,7 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
         amrex::Gpu::streamSynchronize();
 #endif
         // Flush data to disk after looping over all components
-        m_Series->flush();
+        FlushSeries(isBTD);
     } // levels loop (i)
 }
 #endif // WARPX_USE_OPENPMD
@@ -1479,21 +1754,21 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
 //
 //
 //
-WarpXParticleCounter::WarpXParticleCounter (ParticleContainer* pc):
+WarpXParticleCounter::WarpXParticleCounter (ParticleSelection const& selection):
     m_MPIRank{amrex::ParallelDescriptor::MyProc()},
     m_MPISize{amrex::ParallelDescriptor::NProcs()}
 {
-    m_ParticleCounterByLevel.resize(pc->finestLevel()+1);
-    m_ParticleOffsetAtRank.resize(pc->finestLevel()+1);
-    m_ParticleSizeAtRank.resize(pc->finestLevel()+1);
+    auto const nlevels = static_cast<int>(selection.tiles.size());
+    m_ParticleCounterByLevel.resize(nlevels);
+    m_ParticleOffsetAtRank.resize(nlevels);
+    m_ParticleSizeAtRank.resize(nlevels);
 
-    for (auto currentLevel = 0; currentLevel <= pc->finestLevel(); currentLevel++)
+    for (auto currentLevel = 0; currentLevel < nlevels; currentLevel++)
     {
         long numParticles = 0; // numParticles in this processor
 
-        for (ParticleIter pti(*pc, currentLevel); pti.isValid(); ++pti) {
-            auto numParticleOnTile = pti.numParticles();
-            numParticles += numParticleOnTile;
+        for (auto const& tile : selection.tiles[currentLevel]) {
+            numParticles += tile.second.num_selected;
         }
 
         unsigned long long offset=0; // offset of this level
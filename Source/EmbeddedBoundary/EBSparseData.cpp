@@ -0,0 +1,187 @@
+/* Copyright 2026 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "EBSparseData.H"
+
+#include "Utils/TextMsg.H"
+
+#include <AMReX_BLProfiler.H>
+#include <AMReX_Box.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Reduce.H>
+
+#include <limits>
+#include <utility>
+
+namespace
+{
+    /** Minimum and maximum of the first component of mf over the box of index mfi, including guard cells */
+    std::pair<amrex::Real, amrex::Real>
+    fab_min_max (amrex::MultiFab const& mf, amrex::MFIter const& mfi)
+    {
+        auto const& arr = mf.const_array(mfi);
+        amrex::ReduceOps<amrex::ReduceOpMin, amrex::ReduceOpMax> reduce_ops;
+        amrex::ReduceData<amrex::Real, amrex::Real> reduce_data(reduce_ops);
+        reduce_ops.eval(mf[mfi].box(), reduce_data,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) -> amrex::GpuTuple<amrex::Real, amrex::Real> {
+                return {arr(i, j, k), arr(i, j, k)};
+            });
+        auto r = reduce_data.value(reduce_ops);
+        return {amrex::get<0>(r), amrex::get<1>(r)};
+    }
+}
+
+EBSparseData::EBSparseData (ablastr::fields::VectorField const& edge_lengths,
+                            ablastr::fields::VectorField const& face_areas,
+                            std::array<amrex::Real,3> const& cell_size)
+{
+    BL_PROFILE("EBSparseData::EBSparseData");
+
+    // In 2D, the unused edges and faces are zero everywhere (see WarpX::ComputeEdgeLengths
+    // and WarpX::ComputeFaceAreas): their uniform value is zero in all boxes
+    std::array<bool,3> edge_used = {true, true, true};
+    std::array<bool,3> face_used = {true, true, true};
+#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    edge_used = {true, false, true};
+    face_used = {false, true, false};
+#endif
+    for (int idim = 0; idim < 3; ++idim) {
+        m_full_edge_length[idim] = edge_used[idim] ? cell_size[idim] : 0;
+        m_full_face_area[idim] = face_used[idim] ?
+            cell_size[(idim+1)%3]*cell_size[(idim+2)%3] : 0;
+    }
+
+    amrex::BoxArray const& ba = face_areas[0]->boxArray();
+    amrex::DistributionMapping const& dm = face_areas[0]->DistributionMap();
+    m_box_types.define(ba, dm);
+
+    // Classify the local boxes. The classification of all the boxes is then
+    // gathered, since it is needed to build the BoxArray of the cut boxes.
+    constexpr amrex::Real tol = 10*std::numeric_limits<amrex::Real>::epsilon();
+    amrex::Vector<int> all_box_types(ba.size(), static_cast<int>(DistanceToEB::BoxType::Regular));
+    for (amrex::MFIter mfi(*face_areas[0]); mfi.isValid(); ++mfi) {
+        bool regular = true;
+        bool covered = true;
+        for (int idim = 0; idim < 3; ++idim) {
+            if (edge_used[idim]) {
+                auto const [lmin, lmax] = fab_min_max(*edge_lengths[idim], mfi);
+                regular = regular && (lmin >= m_full_edge_length[idim]*(1 - tol));
+                covered = covered && (lmax <= 0);
+            }
+            if (face_used[idim]) {
+                auto const [smin, smax] = fab_min_max(*face_areas[idim], mfi);
+                regular = regular && (smin >= m_full_face_area[idim]*(1 - tol));
+                covered = covered && (smax <= 0);
+            }
+        }
+        DistanceToEB::BoxType box_type = DistanceToEB::BoxType::Cut;
+        if (regular) {
+            box_type = DistanceToEB::BoxType::Regular;
+        } else if (covered) {
+            box_type = DistanceToEB::BoxType::Covered;
+        }
+        m_box_types[mfi] = box_type;
+        all_box_types[mfi.index()] = static_cast<int>(box_type);
+    }
+    // Regular is zero, hence the max over the ranks gives the type set by the owner
+    amrex::ParallelDescriptor::ReduceIntMax(all_box_types.data(), static_cast<int>(all_box_types.size()));
+
+    m_sparse_index.assign(ba.size(), -1);
+    amrex::Vector<int> sparse_pmap;
+    amrex::BoxList sparse_bl;
+    for (int ibox = 0; ibox < static_cast<int>(ba.size()); ++ibox) {
+        if (all_box_types[ibox] == static_cast<int>(DistanceToEB::BoxType::Cut)) {
+            m_sparse_index[ibox] = m_num_cut_boxes++;
+            sparse_bl.push_back(amrex::enclosedCells(ba[ibox]));
+            sparse_pmap.push_back(dm[ibox]);
+        }
+    }
+    if (m_num_cut_boxes == 0) { return; }
+
+    amrex::BoxArray const sparse_ba(std::move(sparse_bl));
+    amrex::DistributionMapping const sparse_dm(std::move(sparse_pmap));
+    for (int idim = 0; idim < 3; ++idim) {
+        amrex::BoxArray const sparse_ba_dim = amrex::convert(sparse_ba, face_areas[idim]->ixType());
+        amrex::IntVect const ngrow = face_areas[idim]->nGrowVect();
+        m_area_mod[idim] = std::make_unique<amrex::MultiFab>(sparse_ba_dim, sparse_dm, 1, ngrow);
+        m_venl[idim] = std::make_unique<amrex::MultiFab>(sparse_ba_dim, sparse_dm, 1, ngrow);
+        m_venl[idim]->setVal(0.);
+
+        for (amrex::MFIter mfi(*face_areas[idim]); mfi.isValid(); ++mfi) {
+            if (m_box_types[mfi] != DistanceToEB::BoxType::Cut) { continue; }
+            auto const& S = face_areas[idim]->const_array(mfi);
+            auto const& S_mod = areaMod(idim, mfi);
+            amrex::ParallelFor((*face_areas[idim])[mfi].box(),
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                    S_mod(i, j, k) = S(i, j, k);
+                });
+        }
+    }
+}
+
+amrex::Array4<amrex::Real>
+EBSparseData::areaMod (int idim, amrex::MFIter const& mfi) const
+{
+    int const isparse = m_sparse_index[mfi.index()];
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(isparse >= 0,
+        "EBSparseData: area_mod is only stored in the boxes cut by the EB");
+    return m_area_mod[idim]->array(isparse);
+}
+
+amrex::Array4<amrex::Real>
+EBSparseData::Venl (int idim, amrex::MFIter const& mfi) const
+{
+    int const isparse = m_sparse_index[mfi.index()];
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(isparse >= 0,
+        "EBSparseData: Venl is only stored in the boxes cut by the EB");
+    return m_venl[idim]->array(isparse);
+}
+
+void
+EBSparseData::setVenlVal (amrex::Real val)
+{
+    if (m_num_cut_boxes == 0) { return; }
+    for (auto const& venl : m_venl) {
+        venl->setVal(val);
+    }
+}
+
+EBGeometryAccessor
+EBSparseData::edgeLength (amrex::MultiFab const& edge_lengths, int idim, amrex::MFIter const& mfi) const
+{
+    return accessor(edge_lengths, m_full_edge_length[idim], mfi);
+}
+
+EBGeometryAccessor
+EBSparseData::faceArea (amrex::MultiFab const& face_areas, int idim, amrex::MFIter const& mfi) const
+{
+    return accessor(face_areas, m_full_face_area[idim], mfi);
+}
+
+EBGeometryAccessor
+EBSparseData::accessor (amrex::MultiFab const& mf, amrex::Real full_value, amrex::MFIter const& mfi) const
+{
+    EBGeometryAccessor acc;
+    switch (m_box_types[mfi]) {
+        case DistanceToEB::BoxType::Regular:
+            acc.m_is_uniform = true;
+            acc.m_uniform_value = full_value;
+            break;
+        case DistanceToEB::BoxType::Covered:
+            acc.m_is_uniform = true;
+            acc.m_uniform_value = 0;
+            break;
+        default:
+            acc.m_arr = mf.const_array(mfi);
+            break;
+    }
+    return acc;
+}
@@ -6,6 +6,7 @@
  */
 
 #include "WarpXFaceInfoBox.H"
+#include "EmbeddedBoundary/EBSparseData.H"
 #include "EmbeddedBoundary/Enabled.H"
 #include "Fields.H"
 #include "Utils/TextMsg.H"
@@ -473,7 +474,10 @@ WarpX::ComputeOneWayExtensions ()
             amrex::Real* borrowing_area = borrowing.area.data();
             int& vecs_size = borrowing.vecs_size;
 
-            auto const &S_mod = m_fields.get(FieldType::area_mod, Direction{idim}, maxLevel())->array(mfi);
+            // Only the boxes cut by the EB can have faces to extend
+            auto const box_type = m_eb_sparse_data[maxLevel()]->boxType(mfi);
+            auto const &S_mod = (box_type == DistanceToEB::BoxType::Cut) ?
+                m_eb_sparse_data[maxLevel()]->areaMod(idim, mfi) : amrex::Array4<amrex::Real>{};
 
             const auto &lx = m_fields.get(FieldType::edge_lengths, Direction{0}, maxLevel())->array(mfi);
             const auto &ly = m_fields.get(FieldType::edge_lengths, Direction{1}, maxLevel())->array(mfi);
@@ -601,7 +605,10 @@ WarpX::ComputeEightWaysExtensions ()
             amrex::Real* borrowing_area = borrowing.area.data();
             int& vecs_size = borrowing.vecs_size;
 
-            auto const &S_mod = m_fields.get(FieldType::area_mod, Direction{idim}, maxLevel())->array(mfi);
+            // Only the boxes cut by the EB can have faces to extend
+            auto const box_type = m_eb_sparse_data[maxLevel()]->boxType(mfi);
+            auto const &S_mod = (box_type == DistanceToEB::BoxType::Cut) ?
+                m_eb_sparse_data[maxLevel()]->areaMod(idim, mfi) : amrex::Array4<amrex::Real>{};
 
             const auto &lx = m_fields.get(FieldType::edge_lengths, Direction{0}, maxLevel())->array(mfi);
             const auto &ly = m_fields.get(FieldType::edge_lengths, Direction{1}, maxLevel())->array(mfi);
@@ -36,10 +36,12 @@
 #  include <AMReX_ParmParse.H>
 #  include <AMReX_Parser.H>
 #  include <AMReX_REAL.H>
+#  include <AMReX_Reduce.H>
 #  include <AMReX_SPACE.H>
 #  include <AMReX_Vector.H>
 
 #  include <cstdlib>
+#  include <memory>
 #  include <string>
 
 using namespace ablastr::fields;
@@ -326,7 +328,6 @@ WarpX::MarkCells ()
             const auto &lx = m_fields.get(FieldType::edge_lengths, Direction{0}, maxLevel())->array(mfi);
             const auto &ly = m_fields.get(FieldType::edge_lengths, Direction{1}, maxLevel())->array(mfi);
             const auto &lz = m_fields.get(FieldType::edge_lengths, Direction{2}, maxLevel())->array(mfi);
-            auto const &mod_areas_dim = m_fields.get(FieldType::area_mod, Direction{idim}, maxLevel())->array(mfi);
 
             const amrex::Real dx = cell_size[0];
             const amrex::Real dy = cell_size[1];
@@ -334,7 +335,6 @@ WarpX::MarkCells ()
 
             amrex::ParallelFor(box, [=] AMREX_GPU_DEVICE (int i, int j, int k) {
                 // Minimal area for this cell to be stable
-                mod_areas_dim(i, j, k) = S(i, j, k);
                 double S_stab;
                 if (idim == 0){
                     S_stab = 0.5 * std::max({ly(i, j, k) * dz, ly(i, j, k + 1) * dz,
@@ -397,5 +397,45 @@ WarpX::ComputeDistanceToEB ()
         auto const eb_fact = fieldEBFactory(lev);
         amrex::FillSignedDistance(*m_fields.get(FieldType::distance_to_eb, lev), eb_level, eb_fact, 1);
     }
+    ComputeEBBoxTypes();
+#endif
+}
+
+void
+WarpX::ComputeEBBoxTypes ()
+{
+#ifdef AMREX_USE_EB
+    BL_PROFILE("ComputeEBBoxTypes");
+    using warpx::fields::FieldType;
+
+    m_eb_box_types.resize(maxLevel()+1);
+    for (int lev=0; lev<=maxLevel(); lev++) {
+        amrex::MultiFab const& distance_to_eb = *m_fields.get(FieldType::distance_to_eb, lev);
+        m_eb_box_types[lev] = std::make_unique<amrex::LayoutData<DistanceToEB::BoxType>>(
+            distance_to_eb.boxArray(), distance_to_eb.DistributionMap());
+
+        for (amrex::MFIter mfi(distance_to_eb); mfi.isValid(); ++mfi) {
+            // All the nodes that can be used to interpolate at the particle positions
+            amrex::Box const& box = mfi.fabbox();
+            auto const& phi = distance_to_eb.const_array(mfi);
+            amrex::ReduceOps<amrex::ReduceOpMin, amrex::ReduceOpMax> reduce_ops;
+            amrex::ReduceData<amrex::Real, amrex::Real> reduce_data(reduce_ops);
+            reduce_ops.eval(box, reduce_data,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k) -> amrex::GpuTuple<amrex::Real, amrex::Real> {
+                    return {phi(i, j, k), phi(i, j, k)};
+                });
+            auto r = reduce_data.value(reduce_ops);
+            amrex::Real const phi_min = amrex::get<0>(r);
+            amrex::Real const phi_max = amrex::get<1>(r);
+
+            DistanceToEB::BoxType box_type = DistanceToEB::BoxType::Cut;
+            if (phi_min > 0) {
+                box_type = DistanceToEB::BoxType::Regular;
+            } else if (phi_max < 0) {
+                box_type = DistanceToEB::BoxType::Covered;
+            }
+            (*m_eb_box_types[lev])[mfi] = box_type;
+        }
+    }
 #endif
 }
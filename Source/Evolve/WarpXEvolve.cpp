@@ -165,6 +165,12 @@ WarpX::Evolve (int numsteps)
         mypc->doQEDSchwinger();
 #endif
 
+        // Accumulate, during the particle push, the moments used by the reduced diagnostics
+        if (reduced_diags->m_plot_rd != 0)
+        {
+            reduced_diags->PrepareParticlePush(step);
+        }
+
         // Main PIC operation:
         // gather fields, push particles, deposit sources, update fields
 
@@ -566,9 +572,11 @@ void WarpX::HandleParticlesAtBoundaries (int step, amrex::Real cur_time, int num
     // interact the particles with EB walls (if present)
     if (EB::enabled()) {
         using warpx::fields::FieldType;
-        mypc->ScrapeParticlesAtEB(m_fields.get_mr_levels(FieldType::distance_to_eb, finest_level));
+        mypc->ScrapeParticlesAtEB(m_fields.get_mr_levels(FieldType::distance_to_eb, finest_level),
+                                  GetEBBoxTypes());
         m_particle_boundary_buffer->gatherParticlesFromEmbeddedBoundaries(
-            *mypc, m_fields.get_mr_levels(FieldType::distance_to_eb, finest_level));
+            *mypc, m_fields.get_mr_levels(FieldType::distance_to_eb, finest_level),
+            GetEBBoxTypes());
         mypc->deleteInvalidParticles();
     }
 
@@ -1129,6 +1137,12 @@ WarpX::PushParticlesandDeposit (int lev, amrex::Real cur_time, DtType a_dt_type,
         current_fp_string = "current_fp";
     }
 
+    // Convert between fluid and particle species at the kinetic region boundaries,
+    // before both are pushed and deposited (not supported with the implicit solvers)
+    if (do_fluid_species && lev == 0 && push_type == PushType::Explicit) {
+        myfl->ConvertSpecies(m_fields, *mypc, lev, cur_time);
+    }
+
     mypc->Evolve(
         m_fields,
         lev,
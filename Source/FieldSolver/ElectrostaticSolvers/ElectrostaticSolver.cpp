@@ -40,6 +40,10 @@ void ElectrostaticSolver::ReadParameters () {
         pp_warpx, "self_fields_max_iters", self_fields_max_iters);
    utils::parser::queryWithParser(
         pp_warpx, "self_fields_verbosity", self_fields_verbosity);
+    pp_warpx.query("self_fields_reuse_solver", self_fields_reuse_solver);
+    if (self_fields_reuse_solver) {
+        m_poisson_solver_cache = std::make_unique<ablastr::fields::PoissonSolverCache>();
+    }
 
     // FFT solver flags
    utils::parser::queryWithParser(
@@ -216,7 +220,8 @@ ElectrostaticSolver::computePhi (
         post_phi_calculation,
         *m_poisson_boundary_handler,
         warpx.gett_new(0),
-        eb_farray_box_factory
+        eb_farray_box_factory,
+        m_poisson_solver_cache.get()
     );
 
 }
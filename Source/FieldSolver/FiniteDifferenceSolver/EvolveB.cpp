@@ -6,6 +6,7 @@
  */
 #include "FiniteDifferenceSolver.H"
 
+#include "EmbeddedBoundary/EBSparseData.H"
 #include "EmbeddedBoundary/WarpXFaceInfoBox.H"
 #include "Fields.H"
 #ifndef WARPX_DIM_RZ
@@ -54,6 +55,7 @@ void FiniteDifferenceSolver::EvolveB (
     PatchType patch_type,
     [[maybe_unused]] std::array< std::unique_ptr<amrex::iMultiFab>, 3 >& flag_info_cell,
     [[maybe_unused]] std::array< std::unique_ptr<amrex::LayoutData<FaceInfoBox> >, 3 >& borrowing,
+    [[maybe_unused]] EBSparseData* eb_sparse_data,
     [[maybe_unused]] amrex::Real const dt )
 {
 
@@ -82,18 +84,10 @@ void FiniteDifferenceSolver::EvolveB (
     if (fields.has_vector(FieldType::face_areas, lev)) {
         face_areas = fields.get_alldirs(FieldType::face_areas, lev);
     }
-    ablastr::fields::VectorField area_mod;
-    if (fields.has_vector(FieldType::area_mod, lev)) {
-        area_mod = fields.get_alldirs(FieldType::area_mod, lev);
-    }
     ablastr::fields::VectorField ECTRhofield;
     if (fields.has_vector(FieldType::ECTRhofield, lev)) {
         ECTRhofield = fields.get_alldirs(FieldType::ECTRhofield, lev);
     }
-    ablastr::fields::VectorField Venl;
-    if (fields.has_vector(FieldType::Venl, lev)) {
-        Venl = fields.get_alldirs(FieldType::Venl, lev);
-    }
 
     if (m_grid_type == GridType::Collocated) {
 
@@ -108,7 +102,7 @@ void FiniteDifferenceSolver::EvolveB (
 
         EvolveBCartesian <CartesianCKCAlgorithm> ( Bfield, Efield, Gfield, lev, dt );
     } else if (m_fdtd_algo == ElectromagneticSolverAlgo::ECT) {
-        EvolveBCartesianECT(Bfield, face_areas, area_mod, ECTRhofield, Venl, flag_info_cell,
+        EvolveBCartesianECT(Bfield, face_areas, ECTRhofield, eb_sparse_data, flag_info_cell,
                             borrowing, lev, dt);
 #endif
     } else {
@@ -222,9 +216,8 @@ void FiniteDifferenceSolver::EvolveBCartesian (
 void FiniteDifferenceSolver::EvolveBCartesianECT (
     ablastr::fields::VectorField const& Bfield,
     ablastr::fields::VectorField const& face_areas,
-    ablastr::fields::VectorField const& area_mod,
     ablastr::fields::VectorField const& ECTRhofield,
-    ablastr::fields::VectorField const& Venl,
+    EBSparseData* eb_sparse_data,
     std::array< std::unique_ptr<amrex::iMultiFab>, 3 >& flag_info_cell,
     std::array< std::unique_ptr<amrex::LayoutData<FaceInfoBox> >, 3 >& borrowing,
     const int lev, amrex::Real const dt ) {
@@ -235,11 +228,12 @@ void FiniteDifferenceSolver::EvolveBCartesianECT (
         "EvolveBCartesianECT: Embedded Boundaries are only implemented in 2D3V and 3D3V");
 #endif
 
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(eb_sparse_data != nullptr,
+        "EvolveBCartesianECT: the EB data are only available on the finest level");
+
     amrex::LayoutData<amrex::Real> *cost = WarpX::getCosts(lev);
 
-    Venl[0]->setVal(0.);
-    Venl[1]->setVal(0.);
-    Venl[2]->setVal(0.);
+    eb_sparse_data->setVenlVal(0.);
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
@@ -252,15 +246,33 @@ void FiniteDifferenceSolver::EvolveBCartesianECT (
         }
         auto wt = static_cast<amrex::Real>(amrex::second());
 
+        // B is not updated in the boxes fully covered by the EB
+        auto const box_type = eb_sparse_data->boxType(mfi);
+        if (box_type == DistanceToEB::BoxType::Covered) { continue; }
+
         for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
             // Extract field data for this grid/tile
             Array4<Real> const &B = Bfield[idim]->array(mfi);
             Array4<Real> const &Rho = ECTRhofield[idim]->array(mfi);
-            Array4<Real> const &Venl_dim = Venl[idim]->array(mfi);
+
+            // Extract tileboxes for which to loop
+            Box const &tb = mfi.tilebox(Bfield[idim]->ixType().toIntVect());
+
+            // In the regular boxes, all the faces are stable and no face is enlarged
+            if (box_type == DistanceToEB::BoxType::Regular) {
+                auto const S = eb_sparse_data->faceArea(*face_areas[idim], idim, mfi);
+                amrex::ParallelFor(tb, [=] AMREX_GPU_DEVICE(int i, int j, int k) {
+                    if (S(i, j, k) <= 0) { return; }
+                    B(i, j, k) = B(i, j, k) - dt * Rho(i, j, k);
+                });
+                continue;
+            }
+
+            Array4<Real> const &Venl_dim = eb_sparse_data->Venl(idim, mfi);
 
             amrex::Array4<int> const &flag_info_cell_dim = flag_info_cell[idim]->array(mfi);
             amrex::Array4<Real> const &S = face_areas[idim]->array(mfi);
-            amrex::Array4<Real> const &S_mod = area_mod[idim]->array(mfi);
+            amrex::Array4<Real> const &S_mod = eb_sparse_data->areaMod(idim, mfi);
 
             auto & borrowing_dim = (*borrowing[idim])[mfi];
             auto * borrowing_dim_neigh_faces = borrowing_dim.neigh_faces.data();
@@ -270,9 +282,6 @@ void FiniteDifferenceSolver::EvolveBCartesianECT (
             auto const &borrowing_size = (*borrowing[idim])[mfi].size.array();
             auto const &borrowing_inds_pointer = (*borrowing[idim])[mfi].inds_pointer.array();
 
-            // Extract tileboxes for which to loop
-            Box const &tb = mfi.tilebox(Bfield[idim]->ixType().toIntVect());
-
             //Take care of the unstable cells
             amrex::ParallelFor(tb, [=] AMREX_GPU_DEVICE(int i, int j, int k) {
 
@@ -377,7 +386,7 @@ void FiniteDifferenceSolver::EvolveBCartesianECT (
         }
     }
 #else
-    amrex::ignore_unused(Bfield, face_areas, area_mod, ECTRhofield, Venl, flag_info_cell, borrowing,
+    amrex::ignore_unused(Bfield, face_areas, ECTRhofield, eb_sparse_data, flag_info_cell, borrowing,
                          lev, dt);
 #endif
 }
@@ -80,10 +80,6 @@ void FiniteDifferenceSolver::EvolveE (
     if (fields.has_vector(FieldType::face_areas, lev)) {
         face_areas = fields.get_alldirs(FieldType::face_areas, lev);
     }
-    ablastr::fields::VectorField area_mod;
-    if (fields.has_vector(FieldType::area_mod, lev)) {
-        area_mod = fields.get_alldirs(FieldType::area_mod, lev);
-    }
     ablastr::fields::VectorField ECTRhofield;
     if (fields.has_vector(FieldType::ECTRhofield, lev)) {
         ECTRhofield = fields.get_alldirs(FieldType::ECTRhofield, lev);
@@ -6,6 +6,7 @@
  */
 #include "FiniteDifferenceSolver.H"
 
+#include "EmbeddedBoundary/EBSparseData.H"
 #ifndef WARPX_DIM_RZ
 #   include "FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
 #   include "FiniteDifferenceAlgorithms/CartesianCKCAlgorithm.H"
@@ -52,16 +53,17 @@ void FiniteDifferenceSolver::EvolveECTRho (
     ablastr::fields::VectorField const& edge_lengths,
     ablastr::fields::VectorField const& face_areas,
     ablastr::fields::VectorField const& ECTRhofield,
+    EBSparseData const* eb_sparse_data,
     const int lev) {
 
 #if !defined(WARPX_DIM_RZ) and defined(AMREX_USE_EB)
     if (m_fdtd_algo == ElectromagneticSolverAlgo::ECT) {
 
-        EvolveRhoCartesianECT(Efield, edge_lengths, face_areas, ECTRhofield, lev);
+        EvolveRhoCartesianECT(Efield, edge_lengths, face_areas, ECTRhofield, eb_sparse_data, lev);
 
     }
 #else
-    amrex::ignore_unused(Efield, edge_lengths, face_areas, ECTRhofield, lev);
+    amrex::ignore_unused(Efield, edge_lengths, face_areas, ECTRhofield, eb_sparse_data, lev);
 #endif
 }
 
@@ -71,7 +73,8 @@ void FiniteDifferenceSolver::EvolveRhoCartesianECT (
     ablastr::fields::VectorField const& Efield,
     ablastr::fields::VectorField const& edge_lengths,
     ablastr::fields::VectorField const& face_areas,
-    ablastr::fields::VectorField const& ECTRhofield, const int lev ) {
+    ablastr::fields::VectorField const& ECTRhofield,
+    EBSparseData const* eb_sparse_data, const int lev ) {
 #ifdef AMREX_USE_EB
 
 #if !(defined(WARPX_DIM_3D) || defined(WARPX_DIM_XZ))
@@ -91,6 +94,23 @@ void FiniteDifferenceSolver::EvolveRhoCartesianECT (
         }
         auto wt = static_cast<amrex::Real>(amrex::second());
 
+        // All the faces are covered: ECTRhofield is not used
+        if (eb_sparse_data &&
+            eb_sparse_data->boxType(mfi) == DistanceToEB::BoxType::Covered) { continue; }
+
+        // In the boxes that are not cut by the EB, the edge lengths and face areas are uniform
+        // and their accessors do not read memory
+        auto edge_length = [&] (int idim) {
+            return eb_sparse_data ?
+                eb_sparse_data->edgeLength(*edge_lengths[idim], idim, mfi) :
+                EBGeometryAccessor{edge_lengths[idim]->const_array(mfi)};
+        };
+        auto face_area = [&] (int idim) {
+            return eb_sparse_data ?
+                eb_sparse_data->faceArea(*face_areas[idim], idim, mfi) :
+                EBGeometryAccessor{face_areas[idim]->const_array(mfi)};
+        };
+
         // Extract field data for this grid/tile
         amrex::Array4<amrex::Real> const &Ex = Efield[0]->array(mfi);
         amrex::Array4<amrex::Real> const &Ey = Efield[1]->array(mfi);
@@ -98,12 +118,12 @@ void FiniteDifferenceSolver::EvolveRhoCartesianECT (
         amrex::Array4<amrex::Real> const &Rhox = ECTRhofield[0]->array(mfi);
         amrex::Array4<amrex::Real> const &Rhoy = ECTRhofield[1]->array(mfi);
         amrex::Array4<amrex::Real> const &Rhoz = ECTRhofield[2]->array(mfi);
-        amrex::Array4<amrex::Real> const &lx = edge_lengths[0]->array(mfi);
-        amrex::Array4<amrex::Real> const &ly = edge_lengths[1]->array(mfi);
-        amrex::Array4<amrex::Real> const &lz = edge_lengths[2]->array(mfi);
-        amrex::Array4<amrex::Real> const &Sx = face_areas[0]->array(mfi);
-        amrex::Array4<amrex::Real> const &Sy = face_areas[1]->array(mfi);
-        amrex::Array4<amrex::Real> const &Sz = face_areas[2]->array(mfi);
+        EBGeometryAccessor const lx = edge_length(0);
+        EBGeometryAccessor const ly = edge_length(1);
+        EBGeometryAccessor const lz = edge_length(2);
+        EBGeometryAccessor const Sx = face_area(0);
+        EBGeometryAccessor const Sy = face_area(1);
+        EBGeometryAccessor const Sz = face_area(2);
 
         // Extract tileboxes for which to loop
         amrex::Box const &trhox = mfi.tilebox(ECTRhofield[0]->ixType().toIntVect());
@@ -158,7 +178,7 @@ void FiniteDifferenceSolver::EvolveRhoCartesianECT (
 #endif
     }
 #else
-    amrex::ignore_unused(Efield, edge_lengths, face_areas, ECTRhofield, lev);
+    amrex::ignore_unused(Efield, edge_lengths, face_areas, ECTRhofield, eb_sparse_data, lev);
 #endif
 }
 #endif
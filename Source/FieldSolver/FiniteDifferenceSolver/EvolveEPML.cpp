@@ -66,8 +66,12 @@ void FiniteDifferenceSolver::EvolveEPML (
         fields.get_alldirs(FieldType::pml_E_fp, level) : fields.get_alldirs(FieldType::pml_E_cp, level);
     const ablastr::fields::VectorField Bfield = (patch_type == PatchType::fine) ?
         fields.get_alldirs(FieldType::pml_B_fp, level) : fields.get_alldirs(FieldType::pml_B_cp, level);
-    const ablastr::fields::VectorField Jfield = (patch_type == PatchType::fine) ?
-        fields.get_alldirs(FieldType::pml_j_fp, level) : fields.get_alldirs(FieldType::pml_j_cp, level);
+    // The current in the PML is only allocated when particles can enter the PML
+    ablastr::fields::VectorField Jfield;
+    if (pml_has_particles) {
+        Jfield = (patch_type == PatchType::fine) ?
+            fields.get_alldirs(FieldType::pml_j_fp, level) : fields.get_alldirs(FieldType::pml_j_cp, level);
+    }
     ablastr::fields::VectorField edge_lengths;
     if (fields.has_vector(FieldType::pml_edge_lengths, level)) {
         edge_lengths = fields.get_alldirs(FieldType::pml_edge_lengths, level);
@@ -13,6 +13,8 @@
 #include "Fields.H"
 #include "WarpX.H"
 
+#include <ablastr/coarsen/sample.H>
+
 using namespace amrex;
 using warpx::fields::FieldType;
 
@@ -29,6 +31,11 @@ void HybridPICModel::ReadParameters ()
     // of sub steps can be specified by the user (defaults to 50).
     utils::parser::queryWithParser(pp_hybrid, "substeps", m_substeps);
 
+    // The ion quantities, which do not change during the substeps, can be
+    // cached once per set of substeps instead of being recomputed by every
+    // E-field solve (at the cost of additional memory).
+    pp_hybrid.query("cache_substep_data", m_cache_substep_data);
+
     // The hybrid model requires an electron temperature, reference density
     // and exponent to be given. These values will be used to calculate the
     // electron pressure according to p = n0 * Te * (n/n0)^gamma
@@ -113,6 +120,31 @@ void HybridPICModel::AllocateLevelMFs (ablastr::fields::MultiFabRegister & field
         lev, amrex::convert(ba, jz_nodal_flag),
         dm, ncomps, IntVect(1), 0.0_rt);
 
+    if (m_cache_substep_data) {
+        // The "hybrid_current_fp_ion_nodal" and "hybrid_enE_nodal_fp" multifabs store
+        // the ion current and the J x B term on the nodal grid during the substeps.
+        // No guard cells are needed since the values are only interpolated to the
+        // Yee grid, which is contained by the nodal grid.
+        fields.alloc_init(FieldType::hybrid_current_fp_ion_nodal,
+            lev, amrex::convert(ba, IntVect::TheNodeVector()),
+            dm, 3, IntVect::TheZeroVector(), 0.0_rt);
+        fields.alloc_init(FieldType::hybrid_enE_nodal_fp,
+            lev, amrex::convert(ba, IntVect::TheNodeVector()),
+            dm, 3, IntVect::TheZeroVector(), 0.0_rt);
+
+        // The "hybrid_rho_fp_edge" multifab stores the floored charge density at
+        // the E-field locations (which match the current staggering).
+        fields.alloc_init(FieldType::hybrid_rho_fp_edge, Direction{0},
+            lev, amrex::convert(ba, jx_nodal_flag),
+            dm, 1, IntVect::TheZeroVector(), 0.0_rt);
+        fields.alloc_init(FieldType::hybrid_rho_fp_edge, Direction{1},
+            lev, amrex::convert(ba, jy_nodal_flag),
+            dm, 1, IntVect::TheZeroVector(), 0.0_rt);
+        fields.alloc_init(FieldType::hybrid_rho_fp_edge, Direction{2},
+            lev, amrex::convert(ba, jz_nodal_flag),
+            dm, 1, IntVect::TheZeroVector(), 0.0_rt);
+    }
+
 #ifdef WARPX_DIM_RZ
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         (ncomps == 1),
@@ -278,7 +310,16 @@ void HybridPICModel::CalculatePlasmaCurrent (
     // the boundary correction was already applied to J_i and the B-field
     // boundary ensures that J itself complies with the boundary conditions, right?
     // ApplyJfieldBoundary(lev, Jfield[0].get(), Jfield[1].get(), Jfield[2].get());
-    for (int i=0; i<3; i++) { current_fp_plasma[i]->FillBoundary(warpx.Geom(lev).periodicity()); }
+    if (m_substep_cache_valid) {
+        // During the substeps, only the guard cell used for the interpolation to the
+        // nodal grid is needed, and the three components are exchanged concurrently.
+        for (int i=0; i<3; i++) {
+            current_fp_plasma[i]->FillBoundary_nowait(0, 1, IntVect(1), warpx.Geom(lev).periodicity());
+        }
+        for (int i=0; i<3; i++) { current_fp_plasma[i]->FillBoundary_finish(); }
+    } else {
+        for (int i=0; i<3; i++) { current_fp_plasma[i]->FillBoundary(warpx.Geom(lev).periodicity()); }
+    }
 
     // Subtract external current from "Ampere" current calculated above. Note
     // we need to include 1 ghost cell since later we will interpolate the
@@ -290,6 +331,90 @@ void HybridPICModel::CalculatePlasmaCurrent (
 
 }
 
+void HybridPICModel::PrepareSubsteps (
+    ablastr::fields::MultiLevelVectorField const& Jifield,
+    ablastr::fields::MultiLevelScalarField const& rhofield)
+{
+    if (!m_cache_substep_data) { return; }
+
+    WARPX_PROFILE("HybridPICModel::PrepareSubsteps()");
+
+    using namespace ablastr::coarsen::sample;
+
+    auto& warpx = WarpX::GetInstance();
+
+    const auto rho_floor = m_n_floor * PhysConst::q_e;
+
+    amrex::GpuArray<int, 3> const& Ex_stag = Ex_IndexType;
+#ifdef WARPX_DIM_RZ
+    // same interpolation of rho as for Etheta in HybridPICSolveECylindrical
+    amrex::GpuArray<int, 3> const& Ey_stag = Ex_IndexType;
+#else
+    amrex::GpuArray<int, 3> const& Ey_stag = Ey_IndexType;
+#endif
+    amrex::GpuArray<int, 3> const& Ez_stag = Ez_IndexType;
+    amrex::GpuArray<int, 3> const& Jx_stag = Jx_IndexType;
+    amrex::GpuArray<int, 3> const& Jy_stag = Jy_IndexType;
+    amrex::GpuArray<int, 3> const& Jz_stag = Jz_IndexType;
+
+    // Parameters for `interp` that maps from Yee to nodal mesh and back
+    amrex::GpuArray<int, 3> const& nodal = {1, 1, 1};
+    // The "coarsening is just 1 i.e. no coarsening"
+    amrex::GpuArray<int, 3> const& coarsen = {1, 1, 1};
+
+    for (int lev = 0; lev <= warpx.finestLevel(); ++lev)
+    {
+        amrex::MultiFab* Ji_nodal_mf = warpx.m_fields.get(FieldType::hybrid_current_fp_ion_nodal, lev);
+        ablastr::fields::VectorField rho_edge = warpx.m_fields.get_alldirs(FieldType::hybrid_rho_fp_edge, lev);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for ( MFIter mfi(*Ji_nodal_mf, TilingIfNotGPU()); mfi.isValid(); ++mfi )
+        {
+            Array4<Real> const& Ji_nodal = Ji_nodal_mf->array(mfi);
+            Array4<Real const> const& Jix = Jifield[lev][0]->const_array(mfi);
+            Array4<Real const> const& Jiy = Jifield[lev][1]->const_array(mfi);
+            Array4<Real const> const& Jiz = Jifield[lev][2]->const_array(mfi);
+
+            ParallelFor(mfi.tilebox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                Ji_nodal(i, j, k, 0) = Interp(Jix, Jx_stag, nodal, coarsen, i, j, k, 0);
+                Ji_nodal(i, j, k, 1) = Interp(Jiy, Jy_stag, nodal, coarsen, i, j, k, 0);
+                Ji_nodal(i, j, k, 2) = Interp(Jiz, Jz_stag, nodal, coarsen, i, j, k, 0);
+            });
+        }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for ( MFIter mfi(*rho_edge[0], TilingIfNotGPU()); mfi.isValid(); ++mfi )
+        {
+            Array4<Real> const& rho_x = rho_edge[0]->array(mfi);
+            Array4<Real> const& rho_y = rho_edge[1]->array(mfi);
+            Array4<Real> const& rho_z = rho_edge[2]->array(mfi);
+            Array4<Real const> const& rho = rhofield[lev]->const_array(mfi);
+
+            Box const& tex = mfi.tilebox(rho_edge[0]->ixType().toIntVect());
+            Box const& tey = mfi.tilebox(rho_edge[1]->ixType().toIntVect());
+            Box const& tez = mfi.tilebox(rho_edge[2]->ixType().toIntVect());
+
+            ParallelFor(tex, tey, tez,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                    rho_x(i, j, k) = amrex::max(Interp(rho, nodal, Ex_stag, coarsen, i, j, k, 0), rho_floor);
+                },
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                    rho_y(i, j, k) = amrex::max(Interp(rho, nodal, Ey_stag, coarsen, i, j, k, 0), rho_floor);
+                },
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                    rho_z(i, j, k) = amrex::max(Interp(rho, nodal, Ez_stag, coarsen, i, j, k, 0), rho_floor);
+                }
+            );
+        }
+    }
+
+    m_substep_cache_valid = true;
+}
+
 void HybridPICModel::HybridPICSolveE (
     ablastr::fields::MultiLevelVectorField const& Efield,
     ablastr::fields::MultiLevelVectorField const& Jfield,
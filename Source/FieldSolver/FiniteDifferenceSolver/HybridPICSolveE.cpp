@@ -15,6 +15,7 @@
 #else
 #   include "FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
 #endif
+#include "Fields.H"
 #include "HybridPICModel/HybridPICModel.H"
 #include "Utils/TextMsg.H"
 #include "WarpX.H"
@@ -22,6 +23,7 @@
 #include <ablastr/coarsen/sample.H>
 
 using namespace amrex;
+using warpx::fields::FieldType;
 
 void FiniteDifferenceSolver::CalculateCurrentAmpere (
     ablastr::fields::VectorField & Jfield,
@@ -417,6 +419,11 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
 
     const bool include_hyper_resistivity_term = (eta_h > 0.0) && solve_for_Faraday;
 
+    // During the B-field substeps, the ion quantities may have been cached
+    // (see HybridPICModel::PrepareSubsteps)
+    const bool use_substep_cache = solve_for_Faraday && hybrid_model->m_substep_cache_valid;
+    auto& warpx = WarpX::GetInstance();
+
     // Index type required for interpolating fields from their respective
     // staggering to the Ex, Ey, Ez locations
     amrex::GpuArray<int, 3> const& Er_stag = hybrid_model->Ex_IndexType;
@@ -441,14 +448,28 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
     //    electron pressure & resistivity terms are added (these terms are
     //    naturally located on the Yee grid).
 
-    // Create a temporary multifab to hold the nodal E-field values
+    // Create a temporary multifab to hold the nodal E-field values, unless
+    // the one allocated for the substeps can be used.
     // Note the multifab has 3 values for Ex, Ey and Ez which we can do here
     // since all three components will be calculated on the same grid.
     // Also note that enE_nodal_mf does not need to have any guard cells since
     // these values will be interpolated to the Yee mesh which is contained
     // by the nodal mesh.
-    auto const& ba = convert(rhofield.boxArray(), IntVect::TheNodeVector());
-    MultiFab enE_nodal_mf(ba, rhofield.DistributionMap(), 3, IntVect::TheZeroVector());
+    MultiFab enE_nodal_tmp;
+    if (!use_substep_cache) {
+        auto const& ba = convert(rhofield.boxArray(), IntVect::TheNodeVector());
+        enE_nodal_tmp.define(ba, rhofield.DistributionMap(), 3, IntVect::TheZeroVector());
+    }
+    MultiFab& enE_nodal_mf = use_substep_cache ?
+        *warpx.m_fields.get(FieldType::hybrid_enE_nodal_fp, lev) : enE_nodal_tmp;
+
+    // Cached ion current on the nodal grid and charge density at the E-field locations
+    MultiFab const* Ji_nodal_mf = nullptr;
+    ablastr::fields::VectorField rho_edge;
+    if (use_substep_cache) {
+        Ji_nodal_mf = warpx.m_fields.get(FieldType::hybrid_current_fp_ion_nodal, lev);
+        rho_edge = warpx.m_fields.get_alldirs(FieldType::hybrid_rho_fp_edge, lev);
+    }
 
     // Loop through the grids, and over the tiles within each grid for the
     // initial, nodal calculation of E
@@ -469,6 +490,10 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
         Array4<Real const> const& Jir = Jifield[0]->const_array(mfi);
         Array4<Real const> const& Jit = Jifield[1]->const_array(mfi);
         Array4<Real const> const& Jiz = Jifield[2]->const_array(mfi);
+        Array4<Real const> Ji_nodal;
+        if (use_substep_cache) {
+            Ji_nodal = Ji_nodal_mf->const_array(mfi);
+        }
         Array4<Real const> const& Br = Bfield[0]->const_array(mfi);
         Array4<Real const> const& Bt = Bfield[1]->const_array(mfi);
         Array4<Real const> const& Bz = Bfield[2]->const_array(mfi);
@@ -481,10 +506,10 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
             auto const jt_interp = Interp(Jt, Jt_stag, nodal, coarsen, i, j, 0, 0);
             auto const jz_interp = Interp(Jz, Jz_stag, nodal, coarsen, i, j, 0, 0);
 
-            // interpolate the ion current to a nodal grid
-            auto const jir_interp = Interp(Jir, Jr_stag, nodal, coarsen, i, j, 0, 0);
-            auto const jit_interp = Interp(Jit, Jt_stag, nodal, coarsen, i, j, 0, 0);
-            auto const jiz_interp = Interp(Jiz, Jz_stag, nodal, coarsen, i, j, 0, 0);
+            // interpolate the ion current to a nodal grid (or use the cached values)
+            auto const jir_interp = use_substep_cache ? Ji_nodal(i, j, 0, 0) : Interp(Jir, Jr_stag, nodal, coarsen, i, j, 0, 0);
+            auto const jit_interp = use_substep_cache ? Ji_nodal(i, j, 0, 1) : Interp(Jit, Jt_stag, nodal, coarsen, i, j, 0, 0);
+            auto const jiz_interp = use_substep_cache ? Ji_nodal(i, j, 0, 2) : Interp(Jiz, Jz_stag, nodal, coarsen, i, j, 0, 0);
 
             // interpolate the B field to a nodal grid
             auto const Br_interp = Interp(Br, Br_stag, nodal, coarsen, i, j, 0, 0);
@@ -535,6 +560,12 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
         Array4<Real const> const& Jz = Jfield[2]->const_array(mfi);
         Array4<Real const> const& enE = enE_nodal_mf.const_array(mfi);
         Array4<Real const> const& rho = rhofield.const_array(mfi);
+        Array4<Real const> rho_e0, rho_e1, rho_e2;
+        if (use_substep_cache) {
+            rho_e0 = rho_edge[0]->const_array(mfi);
+            rho_e1 = rho_edge[1]->const_array(mfi);
+            rho_e2 = rho_edge[2]->const_array(mfi);
+        }
         Array4<Real const> const& Pe = Pefield.const_array(mfi);
 
         amrex::Array4<amrex::Real> lr, lz;
@@ -566,8 +597,8 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
                 // Skip if this cell is fully covered by embedded boundaries
                 if (lr && lr(i, j, 0) <= 0) { return; }
 
-                // Interpolate to get the appropriate charge density in space
-                Real rho_val = Interp(rho, nodal, Er_stag, coarsen, i, j, 0, 0);
+                // Interpolate to get the appropriate charge density in space (or use the cached value)
+                Real rho_val = use_substep_cache ? rho_e0(i, j, 0) : Interp(rho, nodal, Er_stag, coarsen, i, j, 0, 0);
 
                 // Interpolate current to appropriate staggering to match E field
                 Real jtot_val = 0._rt;
@@ -616,8 +647,8 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
                     return;
                 }
 
-                // Interpolate to get the appropriate charge density in space
-                Real rho_val = Interp(rho, nodal, Er_stag, coarsen, i, j, 0, 0);
+                // Interpolate to get the appropriate charge density in space (or use the cached value)
+                Real rho_val = use_substep_cache ? rho_e1(i, j, 0) : Interp(rho, nodal, Er_stag, coarsen, i, j, 0, 0);
 
                 // Interpolate current to appropriate staggering to match E field
                 Real jtot_val = 0._rt;
@@ -651,8 +682,8 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
                 // Skip field solve if this cell is fully covered by embedded boundaries
                 if (lz && lz(i,j,0) <= 0) { return; }
 
-                // Interpolate to get the appropriate charge density in space
-                Real rho_val = Interp(rho, nodal, Ez_stag, coarsen, i, j, 0, 0);
+                // Interpolate to get the appropriate charge density in space (or use the cached value)
+                Real rho_val = use_substep_cache ? rho_e2(i, j, 0) : Interp(rho, nodal, Ez_stag, coarsen, i, j, 0, 0);
 
                 // Interpolate current to appropriate staggering to match E field
                 Real jtot_val = 0._rt;
@@ -722,6 +753,11 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
 
     const bool include_hyper_resistivity_term = (eta_h > 0.) && solve_for_Faraday;
 
+    // During the B-field substeps, the ion quantities may have been cached
+    // (see HybridPICModel::PrepareSubsteps)
+    const bool use_substep_cache = solve_for_Faraday && hybrid_model->m_substep_cache_valid;
+    auto& warpx = WarpX::GetInstance();
+
     // Index type required for interpolating fields from their respective
     // staggering to the Ex, Ey, Ez locations
     amrex::GpuArray<int, 3> const& Ex_stag = hybrid_model->Ex_IndexType;
@@ -746,14 +782,28 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
     //    electron pressure & resistivity terms are added (these terms are
     //    naturally located on the Yee grid).
 
-    // Create a temporary multifab to hold the nodal E-field values
+    // Create a temporary multifab to hold the nodal E-field values, unless
+    // the one allocated for the substeps can be used.
     // Note the multifab has 3 values for Ex, Ey and Ez which we can do here
     // since all three components will be calculated on the same grid.
     // Also note that enE_nodal_mf does not need to have any guard cells since
     // these values will be interpolated to the Yee mesh which is contained
     // by the nodal mesh.
-    auto const& ba = convert(rhofield.boxArray(), IntVect::TheNodeVector());
-    MultiFab enE_nodal_mf(ba, rhofield.DistributionMap(), 3, IntVect::TheZeroVector());
+    MultiFab enE_nodal_tmp;
+    if (!use_substep_cache) {
+        auto const& ba = convert(rhofield.boxArray(), IntVect::TheNodeVector());
+        enE_nodal_tmp.define(ba, rhofield.DistributionMap(), 3, IntVect::TheZeroVector());
+    }
+    MultiFab& enE_nodal_mf = use_substep_cache ?
+        *warpx.m_fields.get(FieldType::hybrid_enE_nodal_fp, lev) : enE_nodal_tmp;
+
+    // Cached ion current on the nodal grid and charge density at the E-field locations
+    MultiFab const* Ji_nodal_mf = nullptr;
+    ablastr::fields::VectorField rho_edge;
+    if (use_substep_cache) {
+        Ji_nodal_mf = warpx.m_fields.get(FieldType::hybrid_current_fp_ion_nodal, lev);
+        rho_edge = warpx.m_fields.get_alldirs(FieldType::hybrid_rho_fp_edge, lev);
+    }
 
     // Loop through the grids, and over the tiles within each grid for the
     // initial, nodal calculation of E
@@ -774,6 +824,10 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
         Array4<Real const> const& Jix = Jifield[0]->const_array(mfi);
         Array4<Real const> const& Jiy = Jifield[1]->const_array(mfi);
         Array4<Real const> const& Jiz = Jifield[2]->const_array(mfi);
+        Array4<Real const> Ji_nodal;
+        if (use_substep_cache) {
+            Ji_nodal = Ji_nodal_mf->const_array(mfi);
+        }
         Array4<Real const> const& Bx = Bfield[0]->const_array(mfi);
         Array4<Real const> const& By = Bfield[1]->const_array(mfi);
         Array4<Real const> const& Bz = Bfield[2]->const_array(mfi);
@@ -786,10 +840,10 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
             auto const jy_interp = Interp(Jy, Jy_stag, nodal, coarsen, i, j, k, 0);
             auto const jz_interp = Interp(Jz, Jz_stag, nodal, coarsen, i, j, k, 0);
 
-            // interpolate the ion current to a nodal grid
-            auto const jix_interp = Interp(Jix, Jx_stag, nodal, coarsen, i, j, k, 0);
-            auto const jiy_interp = Interp(Jiy, Jy_stag, nodal, coarsen, i, j, k, 0);
-            auto const jiz_interp = Interp(Jiz, Jz_stag, nodal, coarsen, i, j, k, 0);
+            // interpolate the ion current to a nodal grid (or use the cached values)
+            auto const jix_interp = use_substep_cache ? Ji_nodal(i, j, k, 0) : Interp(Jix, Jx_stag, nodal, coarsen, i, j, k, 0);
+            auto const jiy_interp = use_substep_cache ? Ji_nodal(i, j, k, 1) : Interp(Jiy, Jy_stag, nodal, coarsen, i, j, k, 0);
+            auto const jiz_interp = use_substep_cache ? Ji_nodal(i, j, k, 2) : Interp(Jiz, Jz_stag, nodal, coarsen, i, j, k, 0);
 
             // interpolate the B field to a nodal grid
             auto const Bx_interp = Interp(Bx, Bx_stag, nodal, coarsen, i, j, k, 0);
@@ -840,6 +894,12 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
         Array4<Real const> const& Jz = Jfield[2]->const_array(mfi);
         Array4<Real const> const& enE = enE_nodal_mf.const_array(mfi);
         Array4<Real const> const& rho = rhofield.const_array(mfi);
+        Array4<Real const> rho_e0, rho_e1, rho_e2;
+        if (use_substep_cache) {
+            rho_e0 = rho_edge[0]->const_array(mfi);
+            rho_e1 = rho_edge[1]->const_array(mfi);
+            rho_e2 = rho_edge[2]->const_array(mfi);
+        }
         Array4<Real const> const& Pe = Pefield.array(mfi);
 
         amrex::Array4<amrex::Real> lx, ly, lz;
@@ -869,8 +929,8 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
                 // Skip if this cell is fully covered by embedded boundaries
                 if (lx && lx(i, j, k) <= 0) { return; }
 
-                // Interpolate to get the appropriate charge density in space
-                Real rho_val = Interp(rho, nodal, Ex_stag, coarsen, i, j, k, 0);
+                // Interpolate to get the appropriate charge density in space (or use the cached value)
+                Real rho_val = use_substep_cache ? rho_e0(i, j, k) : Interp(rho, nodal, Ex_stag, coarsen, i, j, k, 0);
 
                 // Interpolate current to appropriate staggering to match E field
                 Real jtot_val = 0._rt;
@@ -913,8 +973,8 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
                 amrex::ignore_unused(ly);
                 if (lx && (lx(i, j, k)<=0 || lx(i-1, j, k)<=0 || lz(i, j-1, k)<=0 || lz(i, j, k)<=0)) { return; }
 #endif
-                // Interpolate to get the appropriate charge density in space
-                Real rho_val = Interp(rho, nodal, Ey_stag, coarsen, i, j, k, 0);
+                // Interpolate to get the appropriate charge density in space (or use the cached value)
+                Real rho_val = use_substep_cache ? rho_e1(i, j, k) : Interp(rho, nodal, Ey_stag, coarsen, i, j, k, 0);
 
                 // Interpolate current to appropriate staggering to match E field
                 Real jtot_val = 0._rt;
@@ -953,8 +1013,8 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
                 // Skip field solve if this cell is fully covered by embedded boundaries
                 if (lz && lz(i,j,k) <= 0) { return; }
 #endif
-                // Interpolate to get the appropriate charge density in space
-                Real rho_val = Interp(rho, nodal, Ez_stag, coarsen, i, j, k, 0);
+                // Interpolate to get the appropriate charge density in space (or use the cached value)
+                Real rho_val = use_substep_cache ? rho_e2(i, j, k) : Interp(rho, nodal, Ez_stag, coarsen, i, j, k, 0);
 
                 // Interpolate current to appropriate staggering to match E field
                 Real jtot_val = 0._rt;
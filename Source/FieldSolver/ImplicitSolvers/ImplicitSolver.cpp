@@ -1,4 +1,5 @@
 #include "ImplicitSolver.H"
+#include "Fields.H"
 #include "WarpX.H"
 
 using namespace amrex;
@@ -58,3 +59,35 @@ Array<LinOpBCType,AMREX_SPACEDIM> ImplicitSolver::convertFieldBCToLinOpBC (const
     }
     return lbc;
 }
+
+void ImplicitSolver::ComputePlasmaResponse ()
+{
+    if (m_use_plasma_response) { m_WarpX->ImplicitComputePlasmaResponse(m_dt); }
+}
+
+void ImplicitSolver::PreRHSOp ( const amrex::Real  a_cur_time,
+                                const int          a_nl_iter,
+                                const bool         a_from_jacobian )
+{
+    if (a_from_jacobian && m_use_plasma_response_jacobian) {
+        m_WarpX->ImplicitSetLinearizedCurrent();
+    } else {
+        m_WarpX->ImplicitPreRHSOp( a_cur_time, m_dt, a_nl_iter, a_from_jacobian );
+        if (m_use_plasma_response_jacobian) { m_WarpX->ImplicitSaveBaseCurrent(); }
+    }
+}
+
+Real ImplicitSolver::GetMeanPlasmaResponse () const
+{
+    using ablastr::fields::Direction;
+    using warpx::fields::FieldType;
+
+    Real sum = 0.0;
+    Long npts = 0;
+    for (int idir = 0; idir < 3; ++idir) {
+        const MultiFab* response = m_WarpX->m_fields.get(FieldType::plasma_response, Direction{idir}, 0);
+        sum += response->sum(0);
+        npts += response->boxArray().numPts();
+    }
+    return sum/static_cast<Real>(npts);
+}
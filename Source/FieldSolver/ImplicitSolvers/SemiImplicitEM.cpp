@@ -42,6 +42,10 @@ void SemiImplicitEM::PrintParameters () const
     amrex::Print() << "-----------------------------------------------------------\n";
     amrex::Print() << "max particle iterations:    " << m_max_particle_iterations << "\n";
     amrex::Print() << "particle tolerance:         " << m_particle_tolerance << "\n";
+    if (m_max_particle_suborbits > 1) {
+        amrex::Print() << "max particle suborbits:     " << m_max_particle_suborbits << "\n";
+        amrex::Print() << "suborbit gyro-phase:        " << m_suborbit_gyro_phase << "\n";
+    }
     if (m_nlsolver_type==NonlinearSolverType::Picard) {
         amrex::Print() << "Nonlinear solver type:      Picard\n";
     }
@@ -66,6 +70,7 @@ void SemiImplicitEM::OneStep ( amrex::Real  start_time,
 
     // Save up and xp at the start of the time step
     m_WarpX->SaveParticlesAtImplicitStepStart ( );
+    ComputePlasmaResponse();
 
     // Save Eg at the start of the time step
     m_Eold.Copy( FieldType::Efield_fp );
@@ -111,7 +116,7 @@ void SemiImplicitEM::ComputeRHS ( WarpXSolverVec&  a_RHS,
 
     // Update particle positions and velocities using the current state
     // of Eg and Bg. Deposit current density at time n+1/2
-    m_WarpX->ImplicitPreRHSOp( half_time, m_dt, a_nl_iter, a_from_jacobian );
+    PreRHSOp( half_time, a_nl_iter, a_from_jacobian );
 
     // RHS = cvac^2*0.5*dt*( curl(Bg^{n+1/2}) - mu0*Jg^{n+1/2} )
     m_WarpX->ImplicitComputeRHSE(0.5_rt*m_dt, a_RHS);
@@ -44,6 +44,10 @@ void StrangImplicitSpectralEM::PrintParameters () const
     amrex::Print() << "------------------------------------------------------------------------" << "\n";
     amrex::Print() << "max particle iterations:    " << m_max_particle_iterations << "\n";
     amrex::Print() << "particle tolerance:         " << m_particle_tolerance << "\n";
+    if (m_max_particle_suborbits > 1) {
+        amrex::Print() << "max particle suborbits:     " << m_max_particle_suborbits << "\n";
+        amrex::Print() << "suborbit gyro-phase:        " << m_suborbit_gyro_phase << "\n";
+    }
     if (m_nlsolver_type==NonlinearSolverType::Picard) {
         amrex::Print() << "Nonlinear solver type:      Picard\n";
     }
@@ -68,6 +72,7 @@ void StrangImplicitSpectralEM::OneStep ( amrex::Real start_time,
 
     // Save the values at the start of the time step,
     m_WarpX->SaveParticlesAtImplicitStepStart();
+    ComputePlasmaResponse();
 
     // Advance the fields to time n+1/2 source free
     m_WarpX->SpectralSourceFreeFieldAdvance(start_time);
@@ -109,7 +114,7 @@ void StrangImplicitSpectralEM::ComputeRHS ( WarpXSolverVec& a_RHS,
 
     // Self consistently update particle positions and velocities using the
     // current state of the fields E and B. Deposit current density at time n+1/2.
-    m_WarpX->ImplicitPreRHSOp( half_time, m_dt, a_nl_iter, a_from_jacobian );
+    PreRHSOp( half_time, a_nl_iter, a_from_jacobian );
 
     // For Strang split implicit PSATD, the RHS = -dt*mu*c**2*J
     bool const allow_type_mismatch = true;
@@ -64,6 +64,10 @@ void ThetaImplicitEM::PrintParameters () const
     amrex::Print() << "Time-bias parameter theta:  " << m_theta << "\n";
     amrex::Print() << "max particle iterations:    " << m_max_particle_iterations << "\n";
     amrex::Print() << "particle tolerance:         " << m_particle_tolerance << "\n";
+    if (m_max_particle_suborbits > 1) {
+        amrex::Print() << "max particle suborbits:     " << m_max_particle_suborbits << "\n";
+        amrex::Print() << "suborbit gyro-phase:        " << m_suborbit_gyro_phase << "\n";
+    }
     if (m_nlsolver_type==NonlinearSolverType::Picard) {
         amrex::Print() << "Nonlinear solver type:      Picard\n";
     }
@@ -88,6 +92,7 @@ void ThetaImplicitEM::OneStep ( const amrex::Real  start_time,
 
     // Save up and xp at the start of the time step
     m_WarpX->SaveParticlesAtImplicitStepStart ( );
+    ComputePlasmaResponse();
 
     // Save Eg at the start of the time step
     m_Eold.Copy( FieldType::Efield_fp );
@@ -132,7 +137,7 @@ void ThetaImplicitEM::ComputeRHS ( WarpXSolverVec&  a_RHS,
     // Update particle positions and velocities using the current state
     // of Eg and Bg. Deposit current density at time n+1/2
     const amrex::Real theta_time = start_time + m_theta*m_dt;
-    m_WarpX->ImplicitPreRHSOp( theta_time, m_dt, a_nl_iter, a_from_jacobian );
+    PreRHSOp( theta_time, a_nl_iter, a_from_jacobian );
 
     // RHS = cvac^2*m_theta*dt*( curl(Bg^{n+theta}) - mu0*Jg^{n+1/2} )
     m_WarpX->ImplicitComputeRHSE( m_theta*m_dt, a_RHS);
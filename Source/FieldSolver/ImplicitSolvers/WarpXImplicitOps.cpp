@@ -45,6 +45,34 @@
 #include <ostream>
 #include <vector>
 
+namespace
+{
+    /** dst = src + sign*plasma_response*E, on the valid points of each E component */
+    void AddPlasmaResponseCurrent (ablastr::fields::VectorField const& dst,
+                                   ablastr::fields::VectorField const& src,
+                                   ablastr::fields::VectorField const& response,
+                                   ablastr::fields::VectorField const& Efield,
+                                   amrex::Real sign, int ncomps)
+    {
+        for (int idir = 0; idir < 3; ++idir) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+            for (amrex::MFIter mfi(*dst[idir], amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                amrex::Array4<amrex::Real> const& d = dst[idir]->array(mfi);
+                amrex::Array4<amrex::Real const> const& s = src[idir]->const_array(mfi);
+                amrex::Array4<amrex::Real const> const& r = response[idir]->const_array(mfi);
+                amrex::Array4<amrex::Real const> const& E = Efield[idir]->const_array(mfi);
+                amrex::ParallelFor(mfi.tilebox(), ncomps,
+                    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+                {
+                    d(i,j,k,n) = s(i,j,k,n) + sign*r(i,j,k)*E(i,j,k,n);
+                });
+            }
+        }
+    }
+}
+
 void
 WarpX::ImplicitPreRHSOp ( amrex::Real  a_cur_time,
                           amrex::Real  a_full_dt,
@@ -170,6 +198,7 @@ WarpX::SaveParticlesAtImplicitStepStart ( )
             {
 
             auto particle_comps = pc->getParticleComps();
+            auto particle_icomps = pc->getParticleiComps();
 
             for (WarpXParIter pti(*pc, lev); pti.isValid(); ++pti) {
 
@@ -191,6 +220,12 @@ WarpX::SaveParticlesAtImplicitStepStart ( )
                 amrex::ParticleReal* uy_n = pti.GetAttribs(particle_comps["uy_n"]).dataPtr();
                 amrex::ParticleReal* uz_n = pti.GetAttribs(particle_comps["uz_n"]).dataPtr();
 
+                // The number of suborbits is chosen again at the first nonlinear iteration
+                int* nsub = nullptr;
+                if (max_particle_suborbits_in_implicit_scheme > 1) {
+                    nsub = pti.GetiAttribs(particle_icomps["nsub_implicit"]).dataPtr();
+                }
+
                 const long np = pti.numParticles();
 
                 amrex::ParallelFor( np, [=] AMREX_GPU_DEVICE (long ip)
@@ -198,6 +233,8 @@ WarpX::SaveParticlesAtImplicitStepStart ( )
                     amrex::ParticleReal xp, yp, zp;
                     getPosition(ip, xp, yp, zp);
 
+                    if (nsub) { nsub[ip] = 0; }
+
 #if (AMREX_SPACEDIM >= 2)
                     x_n[ip] = xp;
 #endif
@@ -400,3 +437,107 @@ WarpX::ImplicitComputeRHSE (int lev, PatchType patch_type, amrex::Real a_dt, War
     }
 
 }
+
+void
+WarpX::ImplicitComputePlasmaResponse (amrex::Real a_full_dt)
+{
+    WARPX_PROFILE("WarpX::ImplicitComputePlasmaResponse()");
+
+    using namespace amrex::literals;
+    using ablastr::fields::Direction;
+    using warpx::fields::FieldType;
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+
+        ablastr::fields::VectorField const Efield = m_fields.get_alldirs(FieldType::Efield_fp, lev);
+        amrex::DistributionMapping const& dm = Efield[0]->DistributionMap();
+
+        if (!m_fields.has(FieldType::plasma_response, Direction{0}, lev)) {
+            for (int idir = 0; idir < 3; ++idir) {
+                m_fields.alloc_init(FieldType::plasma_response, Direction{idir}, lev,
+                                    Efield[idir]->boxArray(), dm, 1, amrex::IntVect(0), 0.0_rt);
+                m_fields.alloc_init(FieldType::current_fp_base, Direction{idir}, lev,
+                                    Efield[idir]->boxArray(), dm, ncomps, amrex::IntVect(0), 0.0_rt);
+            }
+        }
+
+        // Sum of (q/m)*rho over the species, on the nodes
+        amrex::BoxArray nba = Efield[0]->boxArray();
+        nba.convert(amrex::IntVect::TheNodeVector());
+        amrex::MultiFab rho_species(nba, dm, ncomps, get_ng_depos_rho());
+        amrex::MultiFab response_nodal(nba, dm, 1, 0);
+        response_nodal.setVal(0._rt);
+
+        for (auto const& pc : *mypc) {
+            if (pc->do_not_deposit || pc->getCharge() == 0._prt || pc->getMass() <= 0._prt) { continue; }
+            pc->DepositCharge(&rho_species, lev, false, true, true);
+            auto const q_over_m = static_cast<amrex::Real>(pc->getCharge()/pc->getMass());
+            amrex::MultiFab::Saxpy(response_nodal, q_over_m, rho_species, 0, 0, 1, 0);
+        }
+
+        // In the implicit push, the time-centered velocity responds to E as dv = (q/m)*E*dt/2
+        const amrex::Real fac = 0.5_rt*a_full_dt;
+
+        // Average from the nodes to the locations of each component of E
+        for (int idir = 0; idir < 3; ++idir) {
+            amrex::MultiFab* const response = m_fields.get(FieldType::plasma_response, Direction{idir}, lev);
+            amrex::Dim3 const cc = (amrex::IntVect::TheUnitVector() - response->ixType().toIntVect()).dim3();
+            const amrex::Real weight = fac/static_cast<amrex::Real>((1+cc.x)*(1+cc.y)*(1+cc.z));
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+            for (amrex::MFIter mfi(*response, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                amrex::Array4<amrex::Real> const& resp = response->array(mfi);
+                amrex::Array4<amrex::Real const> const& resp_n = response_nodal.const_array(mfi);
+                amrex::ParallelFor(mfi.tilebox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+                {
+                    amrex::Real sum = 0._rt;
+                    for (int kk = 0; kk <= cc.z; ++kk) {
+                        for (int jj = 0; jj <= cc.y; ++jj) {
+                            for (int ii = 0; ii <= cc.x; ++ii) {
+                                sum += resp_n(i+ii, j+jj, k+kk);
+                            }
+                        }
+                    }
+                    resp(i,j,k) = weight*sum;
+                });
+            }
+        }
+    }
+}
+
+void
+WarpX::ImplicitSaveBaseCurrent ()
+{
+    using namespace amrex::literals;
+    using warpx::fields::FieldType;
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        AddPlasmaResponseCurrent(m_fields.get_alldirs(FieldType::current_fp_base, lev),
+                                 m_fields.get_alldirs(FieldType::current_fp, lev),
+                                 m_fields.get_alldirs(FieldType::plasma_response, lev),
+                                 m_fields.get_alldirs(FieldType::Efield_fp, lev),
+                                 -1._rt, ncomps);
+    }
+}
+
+void
+WarpX::ImplicitSetLinearizedCurrent ()
+{
+    WARPX_PROFILE("WarpX::ImplicitSetLinearizedCurrent()");
+
+    using namespace amrex::literals;
+    using warpx::fields::FieldType;
+
+    // Same field as seen by the particles in ImplicitPreRHSOp
+    if (use_filter) { ApplyFilterMF(m_fields.get_mr_levels_alldirs(FieldType::Efield_fp, finest_level), 0); }
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        AddPlasmaResponseCurrent(m_fields.get_alldirs(FieldType::current_fp, lev),
+                                 m_fields.get_alldirs(FieldType::current_fp_base, lev),
+                                 m_fields.get_alldirs(FieldType::plasma_response, lev),
+                                 m_fields.get_alldirs(FieldType::Efield_fp, lev),
+                                 1._rt, ncomps);
+    }
+}
@@ -907,12 +907,14 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
         m_fdtd_solver_fp[lev]->EvolveB( m_fields,
                                         lev,
                                         patch_type,
-                                        m_flag_info_face[lev], m_borrowing[lev], a_dt );
+                                        m_flag_info_face[lev], m_borrowing[lev],
+                                        m_eb_sparse_data[lev].get(), a_dt );
     } else {
         m_fdtd_solver_cp[lev]->EvolveB( m_fields,
                                         lev,
                                         patch_type,
-                                        m_flag_info_face[lev], m_borrowing[lev], a_dt );
+                                        m_flag_info_face[lev], m_borrowing[lev],
+                                        nullptr, a_dt );
     }
 
     // Evolve B field in PML cells
@@ -1003,12 +1005,14 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt, amrex::Real sta
                                                  m_fields.get_alldirs(FieldType::edge_lengths, lev),
                                                  m_fields.get_alldirs(FieldType::face_areas, lev),
                                                  m_fields.get_alldirs(FieldType::ECTRhofield, lev),
+                                                 m_eb_sparse_data[lev].get(),
                                                  lev );
         } else {
             m_fdtd_solver_cp[lev]->EvolveECTRho( m_fields.get_alldirs(FieldType::Efield_cp, lev),
                                                  m_fields.get_alldirs(FieldType::edge_lengths, lev),
                                                  m_fields.get_alldirs(FieldType::face_areas, lev),
                                                  m_fields.get_alldirs(FieldType::ECTRhofield, lev),
+                                                 nullptr,
                                                  lev);
         }
     }
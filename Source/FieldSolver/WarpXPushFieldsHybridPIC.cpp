@@ -99,6 +99,9 @@ void WarpX::HybridPICEvolveFields ()
         }
     }
 
+    // Cache the ion quantities used during the substeps (if requested)
+    m_hybrid_pic_model->PrepareSubsteps(current_fp_temp, rho_fp_temp);
+
     // Push the B field from t=n to t=n+1/2 using the current and density
     // at t=n, while updating the E field along with B using the electron
     // momentum equation
@@ -127,6 +130,9 @@ void WarpX::HybridPICEvolveFields ()
         );
     }
 
+    m_hybrid_pic_model->PrepareSubsteps(
+        m_fields.get_mr_levels_alldirs(FieldType::current_fp, finest_level), rho_fp_temp);
+
     // Now push the B field from t=n+1/2 to t=n+1 using the n+1/2 quantities
     for (int sub_step = 0; sub_step < sub_steps; sub_step++)
     {
@@ -142,6 +148,8 @@ void WarpX::HybridPICEvolveFields ()
         );
     }
 
+    m_hybrid_pic_model->ClearSubstepCache();
+
     // Extrapolate the ion current density to t=n+1 using
     // J_i^{n+1} = 1/2 * J_i^{n-1/2} + 3/2 * J_i^{n+1/2}, and recalling that
     // now current_fp_temp = J_i^{n} = 1/2 * (J_i^{n-1/2} + J_i^{n+1/2})
@@ -11,16 +11,19 @@
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
+#include <AMReX_Arena.H>
 #include <AMReX_Array4.H>
 #include <AMReX_Box.H>
 #include <AMReX_Config.H>
 #include <AMReX_Extension.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
+#include <AMReX_GpuLaunch.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
 
 #include <algorithm>
+#include <array>
 
 using namespace amrex;
 
@@ -87,103 +90,6 @@ Filter::ApplyStencil (FArrayBox& dstfab, const FArrayBox& srcfab,
     DoFilter(tbx, src, dst, scomp, dcomp, ncomp);
 }
 
-/* \brief Apply stencil (CPU/GPU)
- */
-void Filter::DoFilter (const Box& tbx,
-                       Array4<Real const> const& src,
-                       Array4<Real      > const& dst,
-                       int scomp, int dcomp, int ncomp)
-{
-    AMREX_D_TERM(
-    amrex::Real const* AMREX_RESTRICT s0 = m_stencil_0.data();,
-    amrex::Real const* AMREX_RESTRICT s1 = m_stencil_1.data();,
-    amrex::Real const* AMREX_RESTRICT s2 = m_stencil_2.data();
-    )
-    Dim3 slen_local = slen;
-
-#if AMREX_SPACEDIM == 3
-    AMREX_PARALLEL_FOR_4D ( tbx, ncomp, i, j, k, n,
-    {
-        Real d = 0.0;
-
-        // Pad source array with zeros beyond ghost cells
-        // for out-of-bound accesses due to large-stencil operations
-        const auto src_zeropad = [src] (const int jj, const int kk, const int ll, const int nn) noexcept
-        {
-            return src.contains(jj,kk,ll) ? src(jj,kk,ll,nn) : 0.0_rt;
-        };
-
-        for         (int i2=0; i2 < slen_local.z; ++i2){
-            for     (int i1=0; i1 < slen_local.y; ++i1){
-                for (int i0=0; i0 < slen_local.x; ++i0){
-                    Real sss = s0[i0]*s1[i1]*s2[i2];
-                    d += sss*( src_zeropad(i-i0,j-i1,k-i2,scomp+n)
-                              +src_zeropad(i+i0,j-i1,k-i2,scomp+n)
-                              +src_zeropad(i-i0,j+i1,k-i2,scomp+n)
-                              +src_zeropad(i+i0,j+i1,k-i2,scomp+n)
-                              +src_zeropad(i-i0,j-i1,k+i2,scomp+n)
-                              +src_zeropad(i+i0,j-i1,k+i2,scomp+n)
-                              +src_zeropad(i-i0,j+i1,k+i2,scomp+n)
-                              +src_zeropad(i+i0,j+i1,k+i2,scomp+n));
-                }
-            }
-        }
-
-        dst(i,j,k,dcomp+n) = d;
-    });
-#elif AMREX_SPACEDIM == 2
-    AMREX_PARALLEL_FOR_4D ( tbx, ncomp, i, j, k, n,
-    {
-        Real d = 0.0;
-
-        // Pad source array with zeros beyond ghost cells
-        // for out-of-bound accesses due to large-stencil operations
-        const auto src_zeropad = [src] (const int jj, const int kk, const int ll, const int nn) noexcept
-        {
-            return src.contains(jj,kk,ll) ? src(jj,kk,ll,nn) : 0.0_rt;
-        };
-
-        for         (int i2=0; i2 < slen_local.z; ++i2){
-            for     (int i1=0; i1 < slen_local.y; ++i1){
-                for (int i0=0; i0 < slen_local.x; ++i0){
-                    Real sss = s0[i0]*s1[i1];
-                    d += sss*( src_zeropad(i-i0,j-i1,k,scomp+n)
-                              +src_zeropad(i+i0,j-i1,k,scomp+n)
-                              +src_zeropad(i-i0,j+i1,k,scomp+n)
-                              +src_zeropad(i+i0,j+i1,k,scomp+n));
-                }
-            }
-        }
-
-        dst(i,j,k,dcomp+n) = d;
-    });
-#elif AMREX_SPACEDIM == 1
-    AMREX_PARALLEL_FOR_4D ( tbx, ncomp, i, j, k, n,
-    {
-        Real d = 0.0;
-
-        // Pad source array with zeros beyond ghost cells
-        // for out-of-bound accesses due to large-stencil operations
-        const auto src_zeropad = [src] (const int jj, const int kk, const int ll, const int nn) noexcept
-        {
-            return src.contains(jj,kk,ll) ? src(jj,kk,ll,nn) : 0.0_rt;
-        };
-
-        for         (int i2=0; i2 < slen_local.z; ++i2){
-            for     (int i1=0; i1 < slen_local.y; ++i1){
-                for (int i0=0; i0 < slen_local.x; ++i0){
-                    Real sss = s0[i0];
-                    d += sss*( src_zeropad(i-i0,j,k,scomp+n)
-                              +src_zeropad(i+i0,j,k,scomp+n));
-                }
-            }
-        }
-
-        dst(i,j,k,dcomp+n) = d;
-    });
-#endif
-}
-
 #else
 
 /* \brief Apply stencil on MultiFab (CPU version, 2D/3D).
@@ -265,63 +171,117 @@ Filter::ApplyStencil (amrex::FArrayBox& dstfab, const amrex::FArrayBox& srcfab,
     DoFilter(tbx, tmpfab.array(), dstfab.array(), 0, dcomp, ncomp);
 }
 
+#endif // #ifdef AMREX_USE_CUDA
+
+namespace
+{
+    /* \brief Apply a 1D symmetric stencil along direction dir, on box bx.
+     * The coefficient 0 of the stencil is used twice, hence it is half of the
+     * central weight (see BilinearFilter::ComputeStencils).
+     * \tparam zeropad whether src may be accessed out of its bounds, in which case
+     *         it is padded with zeros
+     */
+    template <bool zeropad>
+    void filter_pass_1d (const Box& bx,
+                         Array4<Real const> const& src,
+                         Array4<Real      > const& dst,
+                         Real const* AMREX_RESTRICT s, int len, int dir,
+                         int scomp, int dcomp, int ncomp)
+    {
+        const int di = (dir == 0) ? 1 : 0;
+        const int dj = (dir == 1) ? 1 : 0;
+        const int dk = (dir == 2) ? 1 : 0;
+        amrex::ParallelFor(bx, ncomp,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+            {
+                const auto src_val = [&] (int ii, int jj, int kk) noexcept
+                {
+                    if constexpr (zeropad) {
+                        return src.contains(ii,jj,kk) ? src(ii,jj,kk,scomp+n) : 0.0_rt;
+                    } else {
+                        return src(ii,jj,kk,scomp+n);
+                    }
+                };
+                Real d = 0.0_rt;
+                for (int m = 0; m < len; ++m) {
+                    d += s[m]*( src_val(i-m*di, j-m*dj, k-m*dk)
+                               +src_val(i+m*di, j+m*dj, k+m*dk));
+                }
+                dst(i,j,k,dcomp+n) = d;
+            });
+    }
+}
+
+/* \brief Apply stencil (CPU/GPU).
+ * The stencil is the tensor product of 1D stencils, hence it is applied as a
+ * sequence of 1D passes, one per direction where the stencil length is larger
+ * than 1. This requires (slen.x + slen.y + slen.z) operations per point instead
+ * of (slen.x * slen.y * slen.z), and no guard cells beyond the stencil length.
+ * The intermediate passes are computed on tbx grown along the directions of the
+ * following passes, in temporary arrays covering the tile only.
+ * \param tbx Box on which the filtered values are computed
+ * \param src Source array. On GPU, it is padded with zeros beyond its bounds.
+ *            On CPU, it is already padded (see ApplyStencil).
+ * \param dst Destination array
+ */
 void Filter::DoFilter (const Box& tbx,
-                       Array4<Real const> const& tmp,
+                       Array4<Real const> const& src,
                        Array4<Real      > const& dst,
                        int scomp, int dcomp, int ncomp)
 {
-    const auto lo = amrex::lbound(tbx);
-    const auto hi = amrex::ubound(tbx);
-    // tmp and dst are of type Array4 (Fortran ordering)
-    AMREX_D_TERM(
-    amrex::Real const* AMREX_RESTRICT s0 = m_stencil_0.data();,
-    amrex::Real const* AMREX_RESTRICT s1 = m_stencil_1.data();,
-    amrex::Real const* AMREX_RESTRICT s2 = m_stencil_2.data();
-    )
-    for (int n = 0; n < ncomp; ++n) {
-        // Set dst value to 0.
-        for         (int k = lo.z; k <= hi.z; ++k) {
-            for     (int j = lo.y; j <= hi.y; ++j) {
-                for (int i = lo.x; i <= hi.x; ++i) {
-                    dst(i,j,k,dcomp+n) = 0.0;
-                }
-            }
-        }
-        // 3 nested loop on 3D stencil
-        for         (int i2=0; i2 < slen.z; ++i2){
-            for     (int i1=0; i1 < slen.y; ++i1){
-                for (int i0=0; i0 < slen.x; ++i0){
-                    const Real sss = AMREX_D_TERM(s0[i0], *s1[i1], *s2[i2]);
-                    // 3 nested loop on 3D array
-                    for         (int k = lo.z; k <= hi.z; ++k) {
-                        for     (int j = lo.y; j <= hi.y; ++j) {
-                            AMREX_PRAGMA_SIMD
-                            for (int i = lo.x; i <= hi.x; ++i) {
-#if AMREX_SPACEDIM == 3
-                                dst(i,j,k,dcomp+n) += sss*(tmp(i-i0,j-i1,k-i2,scomp+n)
-                                                          +tmp(i+i0,j-i1,k-i2,scomp+n)
-                                                          +tmp(i-i0,j+i1,k-i2,scomp+n)
-                                                          +tmp(i+i0,j+i1,k-i2,scomp+n)
-                                                          +tmp(i-i0,j-i1,k+i2,scomp+n)
-                                                          +tmp(i+i0,j-i1,k+i2,scomp+n)
-                                                          +tmp(i-i0,j+i1,k+i2,scomp+n)
-                                                          +tmp(i+i0,j+i1,k+i2,scomp+n));
-#elif AMREX_SPACEDIM == 2
-                                dst(i,j,k,dcomp+n) += sss*(tmp(i-i0,j-i1,k,scomp+n)
-                                                          +tmp(i+i0,j-i1,k,scomp+n)
-                                                          +tmp(i-i0,j+i1,k,scomp+n)
-                                                          +tmp(i+i0,j+i1,k,scomp+n));
-#elif AMREX_SPACEDIM == 1
-                                dst(i,j,k,dcomp+n) += sss*(tmp(i-i0,j,k,scomp+n)
-                                                          +tmp(i+i0,j,k,scomp+n));
+#ifdef AMREX_USE_GPU
+    constexpr bool zeropad = true;
+#else
+    constexpr bool zeropad = false;
 #endif
-                            }
-                        }
-                    }
-                }
+
+    const std::array<Real const*, 3> stencils = {
+        m_stencil_0.data(), m_stencil_1.data(), m_stencil_2.data()};
+    const std::array<int, 3> lengths = {slen.x, slen.y, slen.z};
+
+    // Directions where the stencil is not the identity (length 1)
+    int npasses = 0;
+    std::array<int, 3> pass_dirs = {0, 0, 0};
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        if (lengths[dir] > 1) { pass_dirs[npasses++] = dir; }
+    }
+    // Without any filtering direction, the pass along the first direction is a copy
+    if (npasses == 0) { npasses = 1; }
+
+    // Temporary arrays holding the result of the intermediate passes
+    // (at most two, since the last pass writes into dst)
+    std::array<FArrayBox, 2> tmp_fab;
+
+    Array4<Real const> pass_src = src;
+    int pass_scomp = scomp;
+    for (int ipass = 0; ipass < npasses; ++ipass) {
+        const int dir = pass_dirs[ipass];
+        if (ipass == npasses-1) {
+            if (ipass == 0) {
+                filter_pass_1d<zeropad>(tbx, pass_src, dst, stencils[dir], lengths[dir], dir,
+                                        pass_scomp, dcomp, ncomp);
+            } else {
+                filter_pass_1d<false>(tbx, pass_src, dst, stencils[dir], lengths[dir], dir,
+                                      pass_scomp, dcomp, ncomp);
+            }
+        } else {
+            // Grow the box along the directions of the following passes
+            Box bx = tbx;
+            for (int jpass = ipass+1; jpass < npasses; ++jpass) {
+                bx.grow(pass_dirs[jpass], lengths[pass_dirs[jpass]]-1);
             }
+            FArrayBox& fab = tmp_fab[ipass];
+            fab.resize(bx, ncomp, amrex::The_Async_Arena());
+            const Array4<Real> pass_dst = fab.array();
+            if (ipass == 0) {
+                filter_pass_1d<zeropad>(bx, pass_src, pass_dst, stencils[dir], lengths[dir], dir,
+                                        pass_scomp, 0, ncomp);
+            } else {
+                filter_pass_1d<false>(bx, pass_src, pass_dst, stencils[dir], lengths[dir], dir,
+                                      pass_scomp, 0, ncomp);
+            }
+            pass_src = fab.const_array();
+            pass_scomp = 0;
         }
     }
 }
-
-#endif // #ifdef AMREX_USE_CUDA
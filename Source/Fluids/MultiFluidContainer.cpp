@@ -71,3 +71,16 @@ MultiFluidContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
         fl->Evolve(fields, lev, current_fp_string, cur_time, skip_deposition);
     }
 }
+
+void
+MultiFluidContainer::ConvertSpecies (ablastr::fields::MultiFabRegister& fields,
+                                     MultiParticleContainer& mypc,
+                                     int lev,
+                                     amrex::Real cur_time)
+{
+    for (auto& fl : allcontainers) {
+        if (fl->hasSpeciesConversion()) {
+            fl->ConvertSpecies(fields, mypc, lev, cur_time);
+        }
+    }
+}
@@ -5,7 +5,10 @@
  * License: BSD-3-Clause-LBNL
  */
 #include "Fields.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
 #include "Particles/Pusher/UpdateMomentumHigueraCary.H"
+#include "Particles/WarpXParticleContainer.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
 #include "MusclHancockUtils.H"
@@ -13,14 +16,72 @@
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/WarpXUtil.H"
 #include "Utils/SpeciesUtils.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXConst.H"
 #include "WarpX.H"
 
 #include <ablastr/coarsen/sample.H>
 #include <ablastr/utils/Communication.H>
 
+#include <AMReX_GpuElixir.H>
+#include <AMReX_Random.H>
+#include <AMReX_Scan.H>
+
+#include <cmath>
+
 using namespace ablastr::utils::communication;
 using namespace amrex;
 
+namespace
+{
+    /**
+     * Bounds of the control volume of the fluid node inode along direction idim,
+     * i.e. the node position +/- half a cell, limited to the domain in non-periodic directions
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void node_control_volume_bounds (int inode, int idim,
+        amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> const& problo,
+        amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> const& probhi,
+        amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> const& dx,
+        amrex::GpuArray<int, AMREX_SPACEDIM> const& is_periodic,
+        amrex::Real& lo, amrex::Real& hi)
+    {
+        const amrex::Real xn = problo[idim] + inode*dx[idim];
+        lo = xn - 0.5_rt*dx[idim];
+        hi = xn + 0.5_rt*dx[idim];
+        if (!is_periodic[idim]) {
+            lo = amrex::max(lo, problo[idim]);
+            hi = amrex::min(hi, probhi[idim]);
+        }
+    }
+
+    /**
+     * Volume of the control volume of a fluid node (in RZ, the volume of the
+     * corresponding ring; in 2D and 1D, the volume per unit length/area)
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    amrex::Real node_control_volume (amrex::IntVect const& iv,
+        amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> const& problo,
+        amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> const& probhi,
+        amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> const& dx,
+        amrex::GpuArray<int, AMREX_SPACEDIM> const& is_periodic)
+    {
+        amrex::Real vol = 1._rt;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            amrex::Real lo, hi;
+            node_control_volume_bounds(iv[idim], idim, problo, probhi, dx, is_periodic, lo, hi);
+#if defined(WARPX_DIM_RZ)
+            if (idim == 0) {
+                vol *= MathConst::pi*(hi*hi - lo*lo);
+                continue;
+            }
+#endif
+            vol *= hi - lo;
+        }
+        return vol;
+    }
+}
+
 
 WarpXFluidContainer::WarpXFluidContainer(int ispecies, const std::string &name):
     species_id{ispecies},
@@ -137,6 +198,24 @@ void WarpXFluidContainer::ReadParameters()
         m_Ez_parser = std::make_unique<amrex::Parser>(
             utils::parser::makeParser(str_Ez_ext_function,{"x","y","z","t"}));
     }
+
+    // Conversion between fluid and macroparticles: the plasma is represented by
+    // the particle species `convert_to_particles_species` where kinetic_region > 0
+    pp_species_name.query("convert_to_particles_species", m_conversion_species);
+    if (!m_conversion_species.empty()) {
+        std::string str_kinetic_region_function;
+        utils::parser::Store_parserString(
+            pp_species_name, "kinetic_region(x,y,z,t)",
+            str_kinetic_region_function);
+        m_kinetic_region_parser = std::make_unique<amrex::Parser>(
+            utils::parser::makeParser(str_kinetic_region_function,{"x","y","z","t"}));
+        utils::parser::queryWithParser(pp_species_name, "conversion_num_particles_per_cell", m_conversion_ppc);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_conversion_ppc > 0,
+            species_name + ".conversion_num_particles_per_cell must be positive");
+        // The conversion is done in the explicit particle push only
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::evolve_scheme == EvolveScheme::Explicit,
+            species_name + ".convert_to_particles_species is only supported with algo.evolve_scheme = explicit");
+    }
 }
 
 void WarpXFluidContainer::AllocateLevelMFs(ablastr::fields::MultiFabRegister& fields, const BoxArray &ba, const DistributionMapping &dm, int lev) const
@@ -451,91 +530,108 @@ void WarpXFluidContainer::AdvectivePush_Muscl (ablastr::fields::MultiFabRegister
     const amrex::Real dt_over_dz_half = 0.5_rt*(dt/dx[0]);
 #endif
 
-    const amrex::BoxArray ba = fields.get(name_mf_N, lev)->boxArray();
-
-    // Temporary Half-step values
-#if defined(WARPX_DIM_3D)
-    amrex::MultiFab tmp_U_minus_x( amrex::convert(ba, IntVect(0,1,1)), fields.get(name_mf_N, lev)->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_x( amrex::convert(ba, IntVect(0,1,1)), fields.get(name_mf_N, lev)->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_minus_y( amrex::convert(ba, IntVect(1,0,1)), fields.get(name_mf_N, lev)->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_y( amrex::convert(ba, IntVect(1,0,1)), fields.get(name_mf_N, lev)->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_minus_z( amrex::convert(ba, IntVect(1,1,0)), fields.get(name_mf_N, lev)->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_z( amrex::convert(ba, IntVect(1,1,0)), fields.get(name_mf_N, lev)->DistributionMap(), 4, 1);
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-    amrex::MultiFab tmp_U_minus_x( amrex::convert(ba, IntVect(0,1)), fields.get(name_mf_N, lev)->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_x( amrex::convert(ba, IntVect(0,1)), fields.get(name_mf_N, lev)->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_minus_z( amrex::convert(ba, IntVect(1,0)), fields.get(name_mf_N, lev)->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_z( amrex::convert(ba, IntVect(1,0)), fields.get(name_mf_N, lev)->DistributionMap(), 4, 1);
-#else
-    amrex::MultiFab tmp_U_minus_z( amrex::convert(ba, IntVect(0)), fields.get(name_mf_N, lev)->DistributionMap(), 4, 1);
-    amrex::MultiFab tmp_U_plus_z( amrex::convert(ba, IntVect(0)), fields.get(name_mf_N, lev)->DistributionMap(), 4, 1);
-#endif
+    amrex::MultiFab* N_mf = fields.get(name_mf_N, lev);
+    amrex::MultiFab* NUx_mf = fields.get(name_mf_NU, Direction{0}, lev);
+    amrex::MultiFab* NUy_mf = fields.get(name_mf_NU, Direction{1}, lev);
+    amrex::MultiFab* NUz_mf = fields.get(name_mf_NU, Direction{2}, lev);
+
+    // The edge values of a tile are computed from the nodes of the tile grown by one
+    // cell. With tiling, these nodes may belong to a neighboring tile that has already
+    // been updated: in that case, the edge values are computed from a copy of N and NU.
+    // Without tiling, the grown nodes are guard cells, which are not updated here.
+    const bool use_old_copy = TilingIfNotGPU();
+    amrex::MultiFab N_old, NUx_old, NUy_old, NUz_old;
+    if (use_old_copy) {
+        N_old.define(N_mf->boxArray(), N_mf->DistributionMap(), 1, N_mf->nGrowVect());
+        NUx_old.define(NUx_mf->boxArray(), NUx_mf->DistributionMap(), 1, NUx_mf->nGrowVect());
+        NUy_old.define(NUy_mf->boxArray(), NUy_mf->DistributionMap(), 1, NUy_mf->nGrowVect());
+        NUz_old.define(NUz_mf->boxArray(), NUz_mf->DistributionMap(), 1, NUz_mf->nGrowVect());
+        amrex::MultiFab::Copy(N_old, *N_mf, 0, 0, 1, N_mf->nGrowVect());
+        amrex::MultiFab::Copy(NUx_old, *NUx_mf, 0, 0, 1, NUx_mf->nGrowVect());
+        amrex::MultiFab::Copy(NUy_old, *NUy_mf, 0, 0, 1, NUy_mf->nGrowVect());
+        amrex::MultiFab::Copy(NUz_old, *NUz_mf, 0, 0, 1, NUz_mf->nGrowVect());
+    }
 
-    // Fill edge values of N and U at the half timestep for MUSCL
+    // For each tile, compute the edge values of N and U at the half timestep, then
+    // the fluxes in between nodes, and update N, NU accordingly. The edge values are
+    // only stored in temporary arrays covering the tile.
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
-    for (MFIter mfi(*fields.get(name_mf_N, lev), TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    for (MFIter mfi(*N_mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
+        const amrex::Box tile_box = mfi.tilebox(N_mf->ixType().toIntVect());
 
-        // Loop over a box with one extra gridpoint in the ghost region to avoid
-        // an extra MPI communication between the edge value computation loop and
-        // the flux calculation loop
-        const amrex::Box tile_box = [&](){
+        // The edge values are computed on the tile grown by one node, so that the
+        // fluxes at the faces of the tile are available
+        const amrex::Box edge_box = [&](){
             auto tt = mfi.growntilebox(1);
 #if defined (WARPX_DIM_RZ)
             // Limit the grown box for RZ at r = 0, r_max
             const int idir = 0;
-            const int n_cell = -1;
-            tt.growLo(idir, n_cell);
-            tt.growHi(idir, n_cell);
+            tt.setSmall(idir, amrex::max(tt.smallEnd(idir), domain.smallEnd(idir)));
+            tt.setBig(idir, amrex::min(tt.bigEnd(idir), domain.bigEnd(idir)+1));
 #endif
            return tt;
         }();
 
-        amrex::Array4<Real> const &N_arr = fields.get(name_mf_N, lev)->array(mfi);
-        amrex::Array4<Real> const &NUx_arr = fields.get(name_mf_NU, Direction{0}, lev)->array(mfi);
-        amrex::Array4<Real> const &NUy_arr = fields.get(name_mf_NU, Direction{1}, lev)->array(mfi);
-        amrex::Array4<Real> const &NUz_arr = fields.get(name_mf_NU, Direction{2}, lev)->array(mfi);
+        // Values at the start of the step, used for the edge values
+        amrex::Array4<Real> const &N_arr = use_old_copy ? N_old.array(mfi) : N_mf->array(mfi);
+        amrex::Array4<Real> const &NUx_arr = use_old_copy ? NUx_old.array(mfi) : NUx_mf->array(mfi);
+        amrex::Array4<Real> const &NUy_arr = use_old_copy ? NUy_old.array(mfi) : NUy_mf->array(mfi);
+        amrex::Array4<Real> const &NUz_arr = use_old_copy ? NUz_old.array(mfi) : NUz_mf->array(mfi);
+
+        // Values updated in place
+        amrex::Array4<Real> const &N_new = N_mf->array(mfi);
+        amrex::Array4<Real> const &NUx_new = NUx_mf->array(mfi);
+        amrex::Array4<Real> const &NUy_new = NUy_mf->array(mfi);
+        amrex::Array4<Real> const &NUz_new = NUz_mf->array(mfi);
 
         // Boxes are computed to avoid going out of bounds.
-        // Grow the entire domain
+        // Grow the entire domain, and restrict to the grown tile
         amrex::Box box = mfi.validbox();
         box.grow(1);
 #if defined(WARPX_DIM_3D)
-        amrex::Box const box_x = amrex::convert( box, tmp_U_minus_x.ixType() );
-        amrex::Box const box_y = amrex::convert( box, tmp_U_minus_y.ixType() );
-        amrex::Box const box_z = amrex::convert( box, tmp_U_minus_z.ixType() );
+        amrex::Box const box_x = amrex::convert( box, IntVect(0,1,1) ) & amrex::convert( edge_box, IntVect(0,1,1) );
+        amrex::Box const box_y = amrex::convert( box, IntVect(1,0,1) ) & amrex::convert( edge_box, IntVect(1,0,1) );
+        amrex::Box const box_z = amrex::convert( box, IntVect(1,1,0) ) & amrex::convert( edge_box, IntVect(1,1,0) );
 #elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-        amrex::Box const box_x = amrex::convert( box, tmp_U_minus_x.ixType() );
-        amrex::Box const box_z = amrex::convert( box, tmp_U_minus_z.ixType() );
+        amrex::Box const box_x = amrex::convert( box, IntVect(0,1) ) & amrex::convert( edge_box, IntVect(0,1) );
+        amrex::Box const box_z = amrex::convert( box, IntVect(1,0) ) & amrex::convert( edge_box, IntVect(1,0) );
 #else
-        amrex::Box const box_z = amrex::convert( box, tmp_U_minus_z.ixType() );
+        amrex::Box const box_z = amrex::convert( box, IntVect(0) ) & amrex::convert( edge_box, IntVect(0) );
 #endif
 
-        //N and NU are always defined at the nodes, the tmp_Q_* are defined
+        //N and NU are always defined at the nodes, the U_* are defined
         //in between the nodes (i.e. on the staggered Yee grid) and store the
         //values of N and U at these points.
         //(i.e. the 4 components correspond to N + the 3 components of U)
-        // Extract the temporary arrays for edge values
+        // Temporary arrays for the edge values, protected by Elixir on GPU. They are
+        // allocated with one guard cell since the RZ fluxes read beyond the axis.
+#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        FArrayBox U_minus_x_fab(amrex::grow(box_x, 1), 4);
+        const Elixir U_minus_x_eli = U_minus_x_fab.elixir();
+        const amrex::Array4<amrex::Real> U_minus_x = U_minus_x_fab.array();
+        FArrayBox U_plus_x_fab(amrex::grow(box_x, 1), 4);
+        const Elixir U_plus_x_eli = U_plus_x_fab.elixir();
+        const amrex::Array4<amrex::Real> U_plus_x = U_plus_x_fab.array();
+#endif
 #if defined(WARPX_DIM_3D)
-        const amrex::Array4<amrex::Real> U_minus_x = tmp_U_minus_x.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_x = tmp_U_plus_x.array(mfi);
-        const amrex::Array4<amrex::Real> U_minus_y = tmp_U_minus_y.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_y = tmp_U_plus_y.array(mfi);
-        const amrex::Array4<amrex::Real> U_minus_z = tmp_U_minus_z.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_z = tmp_U_plus_z.array(mfi);
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-        const amrex::Array4<amrex::Real> U_minus_x = tmp_U_minus_x.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_x = tmp_U_plus_x.array(mfi);
-        const amrex::Array4<amrex::Real> U_minus_z = tmp_U_minus_z.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_z = tmp_U_plus_z.array(mfi);
-#else
-        const amrex::Array4<amrex::Real> U_minus_z = tmp_U_minus_z.array(mfi);
-        const amrex::Array4<amrex::Real> U_plus_z = tmp_U_plus_z.array(mfi);
+        FArrayBox U_minus_y_fab(amrex::grow(box_y, 1), 4);
+        const Elixir U_minus_y_eli = U_minus_y_fab.elixir();
+        const amrex::Array4<amrex::Real> U_minus_y = U_minus_y_fab.array();
+        FArrayBox U_plus_y_fab(amrex::grow(box_y, 1), 4);
+        const Elixir U_plus_y_eli = U_plus_y_fab.elixir();
+        const amrex::Array4<amrex::Real> U_plus_y = U_plus_y_fab.array();
 #endif
-
-        amrex::ParallelFor(tile_box,
+        FArrayBox U_minus_z_fab(amrex::grow(box_z, 1), 4);
+        const Elixir U_minus_z_eli = U_minus_z_fab.elixir();
+        const amrex::Array4<amrex::Real> U_minus_z = U_minus_z_fab.array();
+        FArrayBox U_plus_z_fab(amrex::grow(box_z, 1), 4);
+        const Elixir U_plus_z_eli = U_plus_z_fab.elixir();
+        const amrex::Array4<amrex::Real> U_plus_z = U_plus_z_fab.array();
+
+        amrex::ParallelFor(edge_box,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
             {
 
@@ -752,37 +848,8 @@ void WarpXFluidContainer::AdvectivePush_Muscl (ablastr::fields::MultiFabRegister
                 }
             }
         );
-    }
-
-    // Given the values of `U_minus` and `U_plus`, compute fluxes in between nodes, and update N, NU accordingly
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
-#endif
-    for (MFIter mfi(*fields.get(name_mf_N, lev), TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
-        const amrex::Box tile_box = mfi.tilebox(fields.get(name_mf_N, lev)->ixType().toIntVect());
-        const amrex::Array4<Real> N_arr = fields.get(name_mf_N, lev)->array(mfi);
-        const amrex::Array4<Real> NUx_arr = fields.get(name_mf_NU, Direction{0}, lev)->array(mfi);
-        const amrex::Array4<Real> NUy_arr = fields.get(name_mf_NU, Direction{1}, lev)->array(mfi);
-        const amrex::Array4<Real> NUz_arr = fields.get(name_mf_NU, Direction{2}, lev)->array(mfi);
-
-#if defined(WARPX_DIM_3D)
-        amrex::Array4<amrex::Real> const &U_minus_x = tmp_U_minus_x.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_x = tmp_U_plus_x.array(mfi);
-        amrex::Array4<amrex::Real> const &U_minus_y = tmp_U_minus_y.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_y = tmp_U_plus_y.array(mfi);
-        amrex::Array4<amrex::Real> const &U_minus_z = tmp_U_minus_z.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_z = tmp_U_plus_z.array(mfi);
-#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
-        amrex::Array4<amrex::Real> const &U_minus_x = tmp_U_minus_x.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_x = tmp_U_plus_x.array(mfi);
-        amrex::Array4<amrex::Real> const &U_minus_z = tmp_U_minus_z.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_z = tmp_U_plus_z.array(mfi);
-#else
-        amrex::Array4<amrex::Real> const &U_minus_z = tmp_U_minus_z.array(mfi);
-        amrex::Array4<amrex::Real> const &U_plus_z = tmp_U_plus_z.array(mfi);
-#endif
 
+        // Given the values of `U_minus` and `U_plus`, compute fluxes in between nodes, and update N, NU accordingly
         amrex::ParallelFor(tile_box,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
             {
@@ -791,29 +858,29 @@ void WarpXFluidContainer::AdvectivePush_Muscl (ablastr::fields::MultiFabRegister
 #if defined(WARPX_DIM_3D)
 
                 // Update the conserved variables Q = [N, NU] from tn -> tn + dt
-                N_arr(i,j,k) = N_arr(i,j,k)  - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,0,0)
+                N_new(i,j,k) = N_new(i,j,k)  - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,0,0)
                                              - dt_over_dy*dF(U_minus_y,U_plus_y,i,j,k,clight,0,1)
                                              - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,0,2);
-                NUx_arr(i,j,k) = NUx_arr(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,1,0)
+                NUx_new(i,j,k) = NUx_new(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,1,0)
                                                 - dt_over_dy*dF(U_minus_y,U_plus_y,i,j,k,clight,1,1)
                                                 - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,1,2);
-                NUy_arr(i,j,k) = NUy_arr(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,2,0)
+                NUy_new(i,j,k) = NUy_new(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,2,0)
                                                 - dt_over_dy*dF(U_minus_y,U_plus_y,i,j,k,clight,2,1)
                                                 - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,2,2);
-                NUz_arr(i,j,k) = NUz_arr(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,3,0)
+                NUz_new(i,j,k) = NUz_new(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,3,0)
                                                 - dt_over_dy*dF(U_minus_y,U_plus_y,i,j,k,clight,3,1)
                                                 - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,3,2);
 
 #elif defined(WARPX_DIM_XZ)
 
                 // Update the conserved variables Q = [N, NU] from tn -> tn + dt
-                N_arr(i,j,k) = N_arr(i,j,k)  - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,0,0)
+                N_new(i,j,k) = N_new(i,j,k)  - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,0,0)
                                              - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,0,2);
-                NUx_arr(i,j,k) = NUx_arr(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,1,0)
+                NUx_new(i,j,k) = NUx_new(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,1,0)
                                                 - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,1,2);
-                NUy_arr(i,j,k) = NUy_arr(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,2,0)
+                NUy_new(i,j,k) = NUy_new(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,2,0)
                                                 - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,2,2);
-                NUz_arr(i,j,k) = NUz_arr(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,3,0)
+                NUz_new(i,j,k) = NUz_new(i,j,k) - dt_over_dx*dF(U_minus_x,U_plus_x,i,j,k,clight,3,0)
                                                 - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,3,2);
 
 #elif defined(WARPX_DIM_RZ)
@@ -874,18 +941,18 @@ void WarpXFluidContainer::AdvectivePush_Muscl (ablastr::fields::MultiFabRegister
                 }
 
                 // Update the conserved variables from tn -> tn + dt
-                N_arr(i,j,k) = N_arr(i,j,k)     - (dt/Vij)*(F0_plusx - F0_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,0,2)*S_Az);
-                NUx_arr(i,j,k) = NUx_arr(i,j,k) - (dt/Vij)*(F1_plusx - F1_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,1,2)*S_Az);
-                NUy_arr(i,j,k) = NUy_arr(i,j,k) - (dt/Vij)*(F2_plusx - F2_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,2,2)*S_Az);
-                NUz_arr(i,j,k) = NUz_arr(i,j,k) - (dt/Vij)*(F3_plusx - F3_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,3,2)*S_Az);
+                N_new(i,j,k) = N_new(i,j,k)     - (dt/Vij)*(F0_plusx - F0_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,0,2)*S_Az);
+                NUx_new(i,j,k) = NUx_new(i,j,k) - (dt/Vij)*(F1_plusx - F1_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,1,2)*S_Az);
+                NUy_new(i,j,k) = NUy_new(i,j,k) - (dt/Vij)*(F2_plusx - F2_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,2,2)*S_Az);
+                NUz_new(i,j,k) = NUz_new(i,j,k) - (dt/Vij)*(F3_plusx - F3_minusx + dF(U_minus_z,U_plus_z,i,j,k,clight,3,2)*S_Az);
 
 #else
 
                 // Update the conserved variables Q = [N, NU] from tn -> tn + dt
-                N_arr(i,j,k) = N_arr(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,0,2);
-                NUx_arr(i,j,k) = NUx_arr(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,1,2);
-                NUy_arr(i,j,k) = NUy_arr(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,2,2);
-                NUz_arr(i,j,k) = NUz_arr(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,3,2);
+                N_new(i,j,k) = N_new(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,0,2);
+                NUx_new(i,j,k) = NUx_new(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,1,2);
+                NUy_new(i,j,k) = NUy_new(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,2,2);
+                NUz_new(i,j,k) = NUz_new(i,j,k) - dt_over_dz*dF(U_minus_z,U_plus_z,i,j,k,clight,3,2);
 #endif
             }
         );
@@ -1396,3 +1463,313 @@ void WarpXFluidContainer::DepositCurrent(
         );
     }
 }
+
+void WarpXFluidContainer::ConvertSpecies (
+    ablastr::fields::MultiFabRegister& fields,
+    MultiParticleContainer& mypc,
+    int lev,
+    amrex::Real cur_time)
+{
+    WARPX_PROFILE("WarpXFluidContainer::ConvertSpecies");
+
+    auto& pc = mypc.GetParticleContainerFromName(m_conversion_species);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        std::abs(pc.getCharge() - charge) <= 1.e-6_rt*std::abs(charge) &&
+        std::abs(pc.getMass() - mass) <= 1.e-6_rt*std::abs(mass),
+        "The fluid species " + species_name + " and the particle species " + m_conversion_species
+        + " must have the same charge and mass");
+
+    // Absorb the particles first, so that the particles that are created
+    // at this step are not immediately absorbed again
+    ParticlesToFluid(fields, pc, lev, cur_time);
+    FluidToParticles(fields, pc, lev, cur_time);
+}
+
+void WarpXFluidContainer::ParticlesToFluid (
+    ablastr::fields::MultiFabRegister& fields,
+    WarpXParticleContainer& pc,
+    int lev,
+    amrex::Real cur_time)
+{
+    using ablastr::fields::Direction;
+    WARPX_PROFILE("WarpXFluidContainer::ParticlesToFluid");
+
+    WarpX &warpx = WarpX::GetInstance();
+    const amrex::Geometry &geom = warpx.Geom(lev);
+    const amrex::Periodicity &period = geom.periodicity();
+    const auto dx = geom.CellSizeArray();
+    const auto problo = geom.ProbLoArray();
+    const auto probhi = geom.ProbHiArray();
+    const auto dxi = geom.InvCellSizeArray();
+    amrex::GpuArray<int, AMREX_SPACEDIM> is_periodic;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) { is_periodic[idim] = geom.isPeriodic(idim); }
+
+    amrex::MultiFab* N_mf = fields.get(name_mf_N, lev);
+    amrex::MultiFab* NUx_mf = fields.get(name_mf_NU, Direction{0}, lev);
+    amrex::MultiFab* NUy_mf = fields.get(name_mf_NU, Direction{1}, lev);
+    amrex::MultiFab* NUz_mf = fields.get(name_mf_NU, Direction{2}, lev);
+
+    // Density (component 0) and momentum density (components 1-3) of the absorbed
+    // particles, on the fluid nodes. One guard cell receives the contributions of
+    // the particles at the upper edge of the boxes.
+    amrex::MultiFab deposit(N_mf->boxArray(), N_mf->DistributionMap(), 4, 1);
+    deposit.setVal(0.0_rt);
+
+    const auto kinetic_region = m_kinetic_region_parser->compile<4>();
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (WarpXParIter pti(pc, lev); pti.isValid(); ++pti)
+    {
+        const long np = pti.numParticles();
+        if (np == 0) { continue; }
+
+        const auto GetPosition = GetParticlePosition<PIdx>(pti);
+        const amrex::ParticleReal* AMREX_RESTRICT wp = pti.GetAttribs(PIdx::w).dataPtr();
+        const amrex::ParticleReal* AMREX_RESTRICT uxp = pti.GetAttribs(PIdx::ux).dataPtr();
+        const amrex::ParticleReal* AMREX_RESTRICT uyp = pti.GetAttribs(PIdx::uy).dataPtr();
+        const amrex::ParticleReal* AMREX_RESTRICT uzp = pti.GetAttribs(PIdx::uz).dataPtr();
+        uint64_t* AMREX_RESTRICT idcpu = pti.GetStructOfArrays().GetIdCPUData().dataPtr();
+
+        amrex::Array4<amrex::Real> const& dep_arr = deposit.array(pti);
+
+        amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (long ip)
+        {
+            amrex::ParticleReal xp, yp, zp;
+            GetPosition(ip, xp, yp, zp);
+
+            // In RZ, the fluid holds the radial and azimuthal momentum densities, and
+            // the kinetic region is evaluated at (r, 0, z) as on the fluid nodes
+#if defined(WARPX_DIM_RZ)
+            const amrex::ParticleReal rp = std::sqrt(xp*xp + yp*yp);
+            if (kinetic_region(rp, 0._prt, zp, cur_time) > 0._rt) { return; }
+            const amrex::ParticleReal costheta = (rp > 0._prt ? xp/rp : 1._prt);
+            const amrex::ParticleReal sintheta = (rp > 0._prt ? yp/rp : 0._prt);
+            const amrex::ParticleReal u1 = costheta*uxp[ip] + sintheta*uyp[ip];
+            const amrex::ParticleReal u2 = costheta*uyp[ip] - sintheta*uxp[ip];
+#else
+            if (kinetic_region(xp, yp, zp, cur_time) > 0._rt) { return; }
+            const amrex::ParticleReal u1 = uxp[ip];
+            const amrex::ParticleReal u2 = uyp[ip];
+#endif
+
+            // Linear shape factor on the nodes
+#if defined(WARPX_DIM_3D)
+            const amrex::ParticleReal pos[3] = {xp, yp, zp};
+#elif defined(WARPX_DIM_RZ)
+            const amrex::ParticleReal pos[2] = {rp, zp};
+#elif defined(WARPX_DIM_XZ)
+            const amrex::ParticleReal pos[2] = {xp, zp};
+#else
+            const amrex::ParticleReal pos[1] = {zp};
+#endif
+            int i0[3] = {0, 0, 0};
+            amrex::Real sx[3][2] = {{1._rt, 0._rt}, {1._rt, 0._rt}, {1._rt, 0._rt}};
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const auto xi = static_cast<amrex::Real>((pos[idim] - problo[idim])*dxi[idim]);
+                i0[idim] = static_cast<int>(std::floor(xi));
+                const amrex::Real f = xi - i0[idim];
+                sx[idim][0] = 1._rt - f;
+                sx[idim][1] = f;
+            }
+
+            for (int kk = 0; kk < (AMREX_SPACEDIM > 2 ? 2 : 1); ++kk) {
+            for (int jj = 0; jj < (AMREX_SPACEDIM > 1 ? 2 : 1); ++jj) {
+            for (int ii = 0; ii < 2; ++ii) {
+                const amrex::Real s = sx[0][ii]*sx[1][jj]*sx[2][kk];
+                if (s == 0._rt) { continue; }
+                const amrex::IntVect iv(AMREX_D_DECL(i0[0]+ii, i0[1]+jj, i0[2]+kk));
+                const auto n = static_cast<amrex::Real>(wp[ip]*s/node_control_volume(iv, problo, probhi, dx, is_periodic));
+                amrex::HostDevice::Atomic::Add(&dep_arr(iv, 0), n);
+                amrex::HostDevice::Atomic::Add(&dep_arr(iv, 1), static_cast<amrex::Real>(n*u1));
+                amrex::HostDevice::Atomic::Add(&dep_arr(iv, 2), static_cast<amrex::Real>(n*u2));
+                amrex::HostDevice::Atomic::Add(&dep_arr(iv, 3), static_cast<amrex::Real>(n*uzp[ip]));
+            }}}
+
+            amrex::ParticleIDWrapper{idcpu[ip]}.make_invalid();
+        });
+    }
+
+    // Sum the contributions on the nodes shared by several boxes
+    ablastr::utils::communication::SumBoundary(
+        deposit, 0, 4, deposit.nGrowVect(), amrex::IntVect(0),
+        WarpX::do_single_precision_comms, period);
+
+    amrex::MultiFab::Add(*N_mf, deposit, 0, 0, 1, 0);
+    amrex::MultiFab::Add(*NUx_mf, deposit, 1, 0, 1, 0);
+    amrex::MultiFab::Add(*NUy_mf, deposit, 2, 0, 1, 0);
+    amrex::MultiFab::Add(*NUz_mf, deposit, 3, 0, 1, 0);
+
+    pc.deleteInvalidParticles();
+}
+
+void WarpXFluidContainer::FluidToParticles (
+    ablastr::fields::MultiFabRegister& fields,
+    WarpXParticleContainer& pc,
+    int lev,
+    amrex::Real cur_time)
+{
+    using ablastr::fields::Direction;
+    WARPX_PROFILE("WarpXFluidContainer::FluidToParticles");
+
+    WarpX &warpx = WarpX::GetInstance();
+    const amrex::Geometry &geom = warpx.Geom(lev);
+    const amrex::Periodicity &period = geom.periodicity();
+    const auto dx = geom.CellSizeArray();
+    const auto problo = geom.ProbLoArray();
+    const auto probhi = geom.ProbHiArray();
+    amrex::GpuArray<int, AMREX_SPACEDIM> is_periodic;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) { is_periodic[idim] = geom.isPeriodic(idim); }
+
+    amrex::MultiFab* N_mf = fields.get(name_mf_N, lev);
+    amrex::MultiFab* NUx_mf = fields.get(name_mf_NU, Direction{0}, lev);
+    amrex::MultiFab* NUy_mf = fields.get(name_mf_NU, Direction{1}, lev);
+    amrex::MultiFab* NUz_mf = fields.get(name_mf_NU, Direction{2}, lev);
+
+    // Each node shared by several boxes is only converted by its owner
+    auto const &owner_mask = amrex::OwnerMask(*N_mf, period);
+
+    const auto kinetic_region = m_kinetic_region_parser->compile<4>();
+    const int ppc = m_conversion_ppc;
+
+    // Particles to be created on this process
+    amrex::Vector<amrex::ParticleReal> xp, yp, zp, uxp, uyp, uzp;
+    amrex::Vector<amrex::Vector<amrex::ParticleReal>> attr_real(1);
+    amrex::Vector<amrex::Vector<int>> attr_int;
+
+    // The conversion only affects the few nodes that have entered the kinetic region since
+    // the last step: the converted nodes are compacted on the device, and the (cheap)
+    // creation of the macroparticles is done on the host with the standard particle injection
+    for (MFIter mfi(*N_mf); mfi.isValid(); ++mfi)
+    {
+        const amrex::Box box = mfi.validbox();
+        amrex::Array4<Real> const &N_arr = N_mf->array(mfi);
+        amrex::Array4<Real> const &NUx_arr = NUx_mf->array(mfi);
+        amrex::Array4<Real> const &NUy_arr = NUy_mf->array(mfi);
+        amrex::Array4<Real> const &NUz_arr = NUz_mf->array(mfi);
+        const amrex::Array4<int> owner_mask_arr = owner_mask->array(mfi);
+
+        // Flag the nodes to convert
+        const auto n_nodes = static_cast<amrex::Long>(box.numPts());
+        amrex::Gpu::DeviceVector<amrex::Long> flags(n_nodes);
+        amrex::Gpu::DeviceVector<amrex::Long> offsets(n_nodes);
+        amrex::Long* pflags = flags.data();
+        amrex::ParallelFor(box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+        {
+            const amrex::IntVect iv(AMREX_D_DECL(i, j, k));
+#if defined(WARPX_DIM_3D)
+            const amrex::Real x = problo[0] + i * dx[0];
+            const amrex::Real y = problo[1] + j * dx[1];
+            const amrex::Real z = problo[2] + k * dx[2];
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+            const amrex::Real x = problo[0] + i * dx[0];
+            const amrex::Real y = 0.0_rt;
+            const amrex::Real z = problo[1] + j * dx[1];
+#else
+            const amrex::Real x = 0.0_rt;
+            const amrex::Real y = 0.0_rt;
+            const amrex::Real z = problo[0] + i * dx[0];
+#endif
+            amrex::ignore_unused(j, k);
+            pflags[box.index(iv)] = (owner_mask_arr(iv) && N_arr(iv) > 0._rt
+                && kinetic_region(x, y, z, cur_time) > 0._rt) ? 1 : 0;
+        });
+        const amrex::Long n_convert = amrex::Scan::ExclusiveSum(n_nodes, flags.data(), offsets.data());
+        if (n_convert == 0) { continue; }
+
+        // Compact the converted nodes (index in the box, N, NU) and zero the fluid there
+        amrex::Gpu::DeviceVector<amrex::Long> node_index(n_convert);
+        amrex::Gpu::DeviceVector<amrex::Real> node_data(4*n_convert);
+        amrex::Long* pnode_index = node_index.data();
+        amrex::Real* pnode_data = node_data.data();
+        const amrex::Long* poffsets = offsets.data();
+        amrex::ParallelFor(box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+        {
+            const amrex::IntVect iv(AMREX_D_DECL(i, j, k));
+            amrex::ignore_unused(j, k);
+            const auto index = box.index(iv);
+            if (!pflags[index]) { return; }
+            const amrex::Long n = poffsets[index];
+            pnode_index[n] = index;
+            pnode_data[4*n] = N_arr(iv);
+            pnode_data[4*n+1] = NUx_arr(iv);
+            pnode_data[4*n+2] = NUy_arr(iv);
+            pnode_data[4*n+3] = NUz_arr(iv);
+            N_arr(iv) = 0._rt;
+            NUx_arr(iv) = 0._rt;
+            NUy_arr(iv) = 0._rt;
+            NUz_arr(iv) = 0._rt;
+        });
+
+        amrex::Vector<amrex::Long> h_node_index(n_convert);
+        amrex::Vector<amrex::Real> h_node_data(4*n_convert);
+        amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost, node_index.begin(), node_index.end(), h_node_index.begin());
+        amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost, node_data.begin(), node_data.end(), h_node_data.begin());
+        amrex::Gpu::streamSynchronize();
+
+        // Create ppc macroparticles per node, uniformly distributed in the control
+        // volume of the node, with the total charge and momentum of the node
+        for (amrex::Long n = 0; n < n_convert; ++n) {
+            const amrex::IntVect iv = box.atOffset(h_node_index[n]);
+            const amrex::Real N = h_node_data[4*n];
+            const amrex::Real w = N*node_control_volume(iv, problo, probhi, dx, is_periodic)/ppc;
+            amrex::Real lo[AMREX_SPACEDIM], hi[AMREX_SPACEDIM];
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                node_control_volume_bounds(iv[idim], idim, problo, probhi, dx, is_periodic, lo[idim], hi[idim]);
+            }
+            const amrex::Real u1 = h_node_data[4*n+1]/N;
+            const amrex::Real u2 = h_node_data[4*n+2]/N;
+            for (int ip = 0; ip < ppc; ++ip) {
+#if defined(WARPX_DIM_3D)
+                xp.push_back(lo[0] + amrex::Random()*(hi[0] - lo[0]));
+                yp.push_back(lo[1] + amrex::Random()*(hi[1] - lo[1]));
+                zp.push_back(lo[2] + amrex::Random()*(hi[2] - lo[2]));
+#elif defined(WARPX_DIM_RZ)
+                // Uniform in volume in r, random in theta. The radial and azimuthal
+                // momentum of the node is rotated to the Cartesian frame of the particle.
+                const amrex::Real r = std::sqrt(lo[0]*lo[0] + amrex::Random()*(hi[0]*hi[0] - lo[0]*lo[0]));
+                const amrex::Real theta = 2._rt*MathConst::pi*amrex::Random();
+                const amrex::Real costheta = std::cos(theta);
+                const amrex::Real sintheta = std::sin(theta);
+                xp.push_back(r*costheta);
+                yp.push_back(r*sintheta);
+                zp.push_back(lo[1] + amrex::Random()*(hi[1] - lo[1]));
+#elif defined(WARPX_DIM_XZ)
+                xp.push_back(lo[0] + amrex::Random()*(hi[0] - lo[0]));
+                yp.push_back(0._prt);
+                zp.push_back(lo[1] + amrex::Random()*(hi[1] - lo[1]));
+#else
+                xp.push_back(0._prt);
+                yp.push_back(0._prt);
+                zp.push_back(lo[0] + amrex::Random()*(hi[0] - lo[0]));
+#endif
+#if defined(WARPX_DIM_RZ)
+                uxp.push_back(costheta*u1 - sintheta*u2);
+                uyp.push_back(sintheta*u1 + costheta*u2);
+#else
+                uxp.push_back(u1);
+                uyp.push_back(u2);
+#endif
+                uzp.push_back(h_node_data[4*n+3]/N);
+                attr_real[0].push_back(w);
+            }
+        }
+    }
+
+    // Make the copies of the shared nodes consistent with their owner
+    ablastr::utils::communication::OverrideSync(*N_mf, WarpX::do_single_precision_comms, period);
+    ablastr::utils::communication::OverrideSync(*NUx_mf, WarpX::do_single_precision_comms, period);
+    ablastr::utils::communication::OverrideSync(*NUy_mf, WarpX::do_single_precision_comms, period);
+    ablastr::utils::communication::OverrideSync(*NUz_mf, WarpX::do_single_precision_comms, period);
+
+    // AddNParticles redistributes the particles, which is collective:
+    // only call it if any process has created particles
+    const auto np = static_cast<long>(xp.size());
+    long np_total = np;
+    amrex::ParallelDescriptor::ReduceLongSum(np_total);
+    if (np_total > 0) {
+        pc.AddNParticles(lev, np, xp, yp, zp, uxp, uyp, uzp,
+                         1, attr_real, 0, attr_int, 1);
+    }
+}
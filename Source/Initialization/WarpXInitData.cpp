@@ -16,6 +16,7 @@
 #endif
 #include "Diagnostics/MultiDiagnostics.H"
 #include "Diagnostics/ReducedDiags/MultiReducedDiags.H"
+#include "EmbeddedBoundary/EBSparseData.H"
 #include "EmbeddedBoundary/Enabled.H"
 #include "Fields.H"
 #include "FieldSolver/ElectrostaticSolvers/ElectrostaticSolver.H"
@@ -687,7 +688,25 @@ WarpX::InitFromScratch ()
 
         m_implicit_solver->Define(this);
         m_implicit_solver->GetParticleSolverParams( max_particle_its_in_implicit_scheme,
-                                                    particle_tol_in_implicit_scheme );
+                                                    particle_tol_in_implicit_scheme,
+                                                    max_particle_suborbits_in_implicit_scheme,
+                                                    particle_suborbit_gyro_phase );
+
+#if !defined(WARPX_DIM_3D)
+        // In reduced dimensions, the out-of-plane velocities are deposited from the
+        // time-centered momentum and not from the velocity averaged over the suborbits
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            max_particle_suborbits_in_implicit_scheme == 1,
+            "implicit_evolve.max_particle_suborbits > 1 is only supported in 3D");
+#endif
+
+        // With suborbits, the particle displacement is no longer given by the time-centered
+        // velocity: only the deposition schemes based on the positions conserve charge.
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            max_particle_suborbits_in_implicit_scheme == 1 ||
+            current_deposition_algo == CurrentDepositionAlgo::Esirkepov ||
+            current_deposition_algo == CurrentDepositionAlgo::Villasenor,
+            "implicit_evolve.max_particle_suborbits > 1 requires algo.current_deposition = esirkepov or villasenor");
 
         // Add space to save the positions and velocities at the start of the time steps
         for (auto const& pc : *mypc) {
@@ -701,6 +720,9 @@ WarpX::InitFromScratch ()
             pc->NewRealComp("ux_n");
             pc->NewRealComp("uy_n");
             pc->NewRealComp("uz_n");
+            if (max_particle_suborbits_in_implicit_scheme > 1) {
+                pc->NewIntComp("nsub_implicit");
+            }
         }
 
     }
@@ -731,14 +753,15 @@ WarpX::InitPML ()
         bool const eb_enabled = EB::enabled();
 #if (defined WARPX_DIM_RZ) && (defined WARPX_USE_FFT)
         do_pml_Lo[0][0] = 0; // no PML at r=0, in cylindrical geometry
-        pml_rz[0] = std::make_unique<PML_RZ>(0, boxArray(0), DistributionMap(0), &Geom(0), pml_ncell, do_pml_in_domain);
+        // the only PML is at the upper radial boundary
+        pml_rz[0] = std::make_unique<PML_RZ>(0, boxArray(0), DistributionMap(0), &Geom(0), pml_ncell_hi[0], do_pml_in_domain);
 #else
         // Note: fill_guards_fields and fill_guards_current are both set to
         // zero (amrex::IntVect(0)) (what we do with damping BCs does not apply
         // to the PML, for example in the presence of mesh refinement patches)
         pml[0] = std::make_unique<PML>(
             0, boxArray(0), DistributionMap(0), do_similar_dm_pml, &Geom(0), nullptr,
-            pml_ncell, pml_delta, amrex::IntVect::TheZeroVector(),
+            pml_ncell_lo, pml_ncell_hi, pml_delta, amrex::IntVect::TheZeroVector(),
             dt[0], nox_fft, noy_fft, noz_fft, grid_type,
             do_moving_window, pml_has_particles, do_pml_in_domain,
             psatd_solution_type, J_in_time, rho_in_time,
@@ -779,7 +802,7 @@ WarpX::InitPML ()
             pml[lev] = std::make_unique<PML>(
                 lev, boxArray(lev), DistributionMap(lev), do_similar_dm_pml,
                 &Geom(lev), &Geom(lev-1),
-                pml_ncell, pml_delta, refRatio(lev-1),
+                pml_ncell_lo, pml_ncell_hi, pml_delta, refRatio(lev-1),
                 dt[lev], nox_fft, noy_fft, noz_fft, grid_type,
                 do_moving_window, pml_has_particles, do_pml_in_domain,
                 psatd_solution_type, J_in_time, rho_in_time, do_pml_dive_cleaning, do_pml_divb_cleaning,
@@ -1012,6 +1035,7 @@ WarpX::InitLevelData (int lev, Real /*time*/)
                     m_fields.get_alldirs(FieldType::edge_lengths, lev),
                     m_fields.get_mr_levels_alldirs(FieldType::face_areas, max_level)[lev],
                     m_fields.get_alldirs(FieldType::ECTRhofield, lev),
+                    m_eb_sparse_data[lev].get(),
                     lev);
             }
         }
@@ -1044,6 +1068,7 @@ WarpX::InitLevelData (int lev, Real /*time*/)
                         m_fields.get_alldirs(FieldType::edge_lengths, lev),
                         m_fields.get_mr_levels_alldirs(FieldType::face_areas, max_level)[lev],
                         m_fields.get_alldirs(FieldType::ECTRhofield, lev),
+                        nullptr,
                         lev);
                 }
             }
@@ -1309,6 +1334,8 @@ void WarpX::InitializeEBGridData (int lev)
             ScaleAreas(face_areas_lev, CellSize(lev));
 
             if (WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::ECT) {
+                m_eb_sparse_data[lev] = std::make_unique<EBSparseData>(
+                    edge_lengths_lev, face_areas_lev, CellSize(lev));
                 MarkCells();
                 ComputeFaceExtensions();
             }
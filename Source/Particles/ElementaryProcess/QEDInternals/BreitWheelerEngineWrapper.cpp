@@ -6,11 +6,13 @@
  */
 #include "BreitWheelerEngineWrapper.H"
 
+#include "QedTableGenerationUtils.H"
 #include "Utils/TextMsg.H"
 
 #include <AMReX.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_GpuDevice.H>
+#include <AMReX_ParallelDescriptor.H>
 
 #include <picsar_qed/physics/breit_wheeler/breit_wheeler_engine_tables.hpp>
 //Functions needed to generate a new table
@@ -21,6 +23,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <iosfwd>
@@ -46,7 +49,7 @@ BreitWheelerEngine::build_evolve_functor () const
 {
     AMREX_ALWAYS_ASSERT(m_lookup_tables_initialized);
 
-    return {m_dndt_table.get_view(), m_bw_minimum_chi_phot};
+    return {get_dndt_table_view(), m_bw_minimum_chi_phot};
 }
 
 BreitWheelerGeneratePairs
@@ -54,7 +57,7 @@ BreitWheelerEngine::build_pair_functor () const
 {
     AMREX_ALWAYS_ASSERT(m_lookup_tables_initialized);
 
-    return {m_pair_prod_table.get_view()};
+    return {get_pair_prod_table_view()};
 }
 
 bool BreitWheelerEngine::are_lookup_tables_initialized () const
@@ -103,9 +106,36 @@ void BreitWheelerEngine::init_builtin_tables(
     m_lookup_tables_initialized = true;
 }
 
+void BreitWheelerEngine::init_node_shared_lookup_tables (
+    const vector<char>& raw_data,
+    const amrex::ParticleReal bw_minimum_chi_phot)
+{
+#ifdef AMREX_USE_GPU
+    amrex::ignore_unused(raw_data, bw_minimum_chi_phot);
+    WARPX_ABORT_WITH_MESSAGE("Node-shared QED lookup tables are not supported on GPU!");
+#else
+    m_node_shared_tables = std::make_shared<QedNodeSharedTables<
+        BW_dndt_table_params, BW_pair_prod_table_params>>(
+        raw_data,
+        [](const BW_dndt_table_params& params){
+            return params.chi_phot_how_many;},
+        [](const BW_pair_prod_table_params& params){
+            return params.chi_phot_how_many*params.frac_how_many;});
+
+    // the tables owned by this rank (if any) are no longer needed
+    m_dndt_table = BW_dndt_table{};
+    m_pair_prod_table = BW_pair_prod_table{};
+
+    m_bw_minimum_chi_phot = bw_minimum_chi_phot;
+
+    m_lookup_tables_initialized = true;
+#endif
+}
+
 vector<char> BreitWheelerEngine::export_lookup_tables_data () const
 {
-    if(!m_lookup_tables_initialized) {
+    // node-shared tables are not owned by this rank and cannot be exported
+    if(!m_lookup_tables_initialized || m_node_shared_tables) {
         return vector<char>{};
     }
 
@@ -126,6 +156,24 @@ vector<char> BreitWheelerEngine::export_lookup_tables_data () const
     return res;
 }
 
+BW_dndt_table_view
+BreitWheelerEngine::get_dndt_table_view () const
+{
+    if (m_node_shared_tables) {
+        return m_node_shared_tables->view_a<BW_dndt_table_view>();
+    }
+    return m_dndt_table.get_view();
+}
+
+BW_pair_prod_table_view
+BreitWheelerEngine::get_pair_prod_table_view () const
+{
+    if (m_node_shared_tables) {
+        return m_node_shared_tables->view_b<BW_pair_prod_table_view>();
+    }
+    return m_pair_prod_table.get_view();
+}
+
 PicsarBreitWheelerCtrl
 BreitWheelerEngine::get_default_ctrl() const
 {
@@ -162,6 +210,41 @@ void BreitWheelerEngine::compute_lookup_tables (
 #endif
 }
 
+void BreitWheelerEngine::compute_lookup_tables_distributed (
+    PicsarBreitWheelerCtrl ctrl,
+    const amrex::ParticleReal bw_minimum_chi_phot)
+{
+#ifdef WARPX_QED_TABLE_GEN
+    using Params_dndt = BW_dndt_table_params;
+    using Params_pair_prod = BW_pair_prod_table_params;
+
+    const int ioproc = ParallelDescriptor::IOProcessorNumber();
+
+    const auto dndt_vals = QedUtils::generate_table_distributed<BW_dndt_table>(
+        ctrl.dndt_params,
+        &Params_dndt::chi_phot_min, &Params_dndt::chi_phot_max, &Params_dndt::chi_phot_how_many,
+        1, ioproc);
+
+    const auto pair_prod_vals = QedUtils::generate_table_distributed<BW_pair_prod_table>(
+        ctrl.pair_prod_params,
+        &Params_pair_prod::chi_phot_min, &Params_pair_prod::chi_phot_max, &Params_pair_prod::chi_phot_how_many,
+        static_cast<std::size_t>(ctrl.pair_prod_params.frac_how_many), ioproc);
+
+    if (ParallelDescriptor::MyProc() == ioproc) {
+        m_dndt_table = BW_dndt_table{ctrl.dndt_params, dndt_vals};
+        m_pair_prod_table = BW_pair_prod_table{ctrl.pair_prod_params, pair_prod_vals};
+        m_bw_minimum_chi_phot = bw_minimum_chi_phot;
+
+        amrex::Gpu::synchronize();
+
+        m_lookup_tables_initialized = true;
+    }
+#else
+    amrex::ignore_unused(ctrl, bw_minimum_chi_phot);
+    WARPX_ABORT_WITH_MESSAGE("WarpX was not compiled with table generation support!");
+#endif
+}
+
 void BreitWheelerEngine::init_builtin_dndt_table()
 {
     constexpr auto default_chi_phot_min = 0.02_prt;
@@ -6,11 +6,13 @@
  */
 #include "QuantumSyncEngineWrapper.H"
 
+#include "QedTableGenerationUtils.H"
 #include "Utils/TextMsg.H"
 
 #include <AMReX.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_GpuDevice.H>
+#include <AMReX_ParallelDescriptor.H>
 
 #include "picsar_qed/physics/quantum_sync/quantum_sync_engine_tables.hpp"
 //Functions needed to generate a new table
@@ -21,6 +23,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <iosfwd>
@@ -45,14 +48,14 @@ QuantumSynchrotronEvolveOpticalDepth QuantumSynchrotronEngine::build_evolve_func
 {
     AMREX_ALWAYS_ASSERT(m_lookup_tables_initialized);
 
-    return {m_dndt_table.get_view(), m_qs_minimum_chi_part};
+    return {get_dndt_table_view(), m_qs_minimum_chi_part};
 }
 
 QuantumSynchrotronPhotonEmission QuantumSynchrotronEngine::build_phot_em_functor ()
 {
     AMREX_ALWAYS_ASSERT(m_lookup_tables_initialized);
 
-    return {m_phot_em_table.get_view()};
+    return {get_phot_em_table_view()};
 
 }
 
@@ -102,9 +105,36 @@ void QuantumSynchrotronEngine::init_builtin_tables(
     m_lookup_tables_initialized = true;
 }
 
+void QuantumSynchrotronEngine::init_node_shared_lookup_tables (
+    const vector<char>& raw_data,
+    const amrex::ParticleReal qs_minimum_chi_part)
+{
+#ifdef AMREX_USE_GPU
+    amrex::ignore_unused(raw_data, qs_minimum_chi_part);
+    WARPX_ABORT_WITH_MESSAGE("Node-shared QED lookup tables are not supported on GPU!");
+#else
+    m_node_shared_tables = std::make_shared<QedNodeSharedTables<
+        QS_dndt_table_params, QS_phot_em_table_params>>(
+        raw_data,
+        [](const QS_dndt_table_params& params){
+            return params.chi_part_how_many;},
+        [](const QS_phot_em_table_params& params){
+            return params.chi_part_how_many*params.frac_how_many;});
+
+    // the tables owned by this rank (if any) are no longer needed
+    m_dndt_table = QS_dndt_table{};
+    m_phot_em_table = QS_phot_em_table{};
+
+    m_qs_minimum_chi_part = qs_minimum_chi_part;
+
+    m_lookup_tables_initialized = true;
+#endif
+}
+
 vector<char> QuantumSynchrotronEngine::export_lookup_tables_data () const
 {
-    if(!m_lookup_tables_initialized) {
+    // node-shared tables are not owned by this rank and cannot be exported
+    if(!m_lookup_tables_initialized || m_node_shared_tables) {
         return vector<char>{};
     }
 
@@ -125,6 +155,24 @@ vector<char> QuantumSynchrotronEngine::export_lookup_tables_data () const
     return res;
 }
 
+QS_dndt_table_view
+QuantumSynchrotronEngine::get_dndt_table_view () const
+{
+    if (m_node_shared_tables) {
+        return m_node_shared_tables->view_a<QS_dndt_table_view>();
+    }
+    return m_dndt_table.get_view();
+}
+
+QS_phot_em_table_view
+QuantumSynchrotronEngine::get_phot_em_table_view () const
+{
+    if (m_node_shared_tables) {
+        return m_node_shared_tables->view_b<QS_phot_em_table_view>();
+    }
+    return m_phot_em_table.get_view();
+}
+
 PicsarQuantumSyncCtrl
 QuantumSynchrotronEngine::get_default_ctrl() const
 {
@@ -161,6 +209,41 @@ void QuantumSynchrotronEngine::compute_lookup_tables (
 #endif
 }
 
+void QuantumSynchrotronEngine::compute_lookup_tables_distributed (
+    PicsarQuantumSyncCtrl ctrl,
+    const amrex::ParticleReal qs_minimum_chi_part)
+{
+#ifdef WARPX_QED_TABLE_GEN
+    using Params_dndt = QS_dndt_table_params;
+    using Params_phot_em = QS_phot_em_table_params;
+
+    const int ioproc = ParallelDescriptor::IOProcessorNumber();
+
+    const auto dndt_vals = QedUtils::generate_table_distributed<QS_dndt_table>(
+        ctrl.dndt_params,
+        &Params_dndt::chi_part_min, &Params_dndt::chi_part_max, &Params_dndt::chi_part_how_many,
+        1, ioproc);
+
+    const auto phot_em_vals = QedUtils::generate_table_distributed<QS_phot_em_table>(
+        ctrl.phot_em_params,
+        &Params_phot_em::chi_part_min, &Params_phot_em::chi_part_max, &Params_phot_em::chi_part_how_many,
+        static_cast<std::size_t>(ctrl.phot_em_params.frac_how_many), ioproc);
+
+    if (ParallelDescriptor::MyProc() == ioproc) {
+        m_dndt_table = QS_dndt_table{ctrl.dndt_params, dndt_vals};
+        m_phot_em_table = QS_phot_em_table{ctrl.phot_em_params, phot_em_vals};
+        m_qs_minimum_chi_part = qs_minimum_chi_part;
+
+        amrex::Gpu::synchronize();
+
+        m_lookup_tables_initialized = true;
+    }
+#else
+    amrex::ignore_unused(ctrl, qs_minimum_chi_part);
+    WARPX_ABORT_WITH_MESSAGE("WarpX was not compiled with table generation support!");
+#endif
+}
+
 void QuantumSynchrotronEngine::init_builtin_dndt_table()
 {
     constexpr auto default_chi_part_min = 1.0e-3_prt;
@@ -15,6 +15,7 @@
 #include "Particles/ElementaryProcess/Ionization.H"
 #ifdef WARPX_QED
 #   include "Particles/ElementaryProcess/QEDInternals/BreitWheelerEngineWrapper.H"
+#   include "Particles/ElementaryProcess/QEDInternals/QedTableGenerationUtils.H"
 #   include "Particles/ElementaryProcess/QEDInternals/QuantumSyncEngineWrapper.H"
 #   include "Particles/ElementaryProcess/QEDSchwingerProcess.H"
 #   include "Particles/ElementaryProcess/QEDPairGeneration.H"
@@ -45,7 +46,9 @@
 #include "WarpX.H"
 
 #include <ablastr/fields/MultiFabRegister.H>
+#include <ablastr/parallelization/NodeSharedBuffer.H>
 #include <ablastr/utils/Communication.H>
+#include <ablastr/utils/Serialization.H>
 #include <ablastr/warn_manager/WarnManager.H>
 
 #include <AMReX.H>
@@ -74,9 +77,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <filesystem>
 #include <limits>
 #include <map>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -90,6 +96,70 @@ namespace
     {
         Array4< amrex::Real const > const Ex, Ey, Ez, Bx, By, Bz;
     };
+
+#ifdef WARPX_QED
+    /** Hash of the parameters of the Quantum Synchrotron lookup tables, used for the table cache */
+    std::string GetQuantumSyncTableHash (const PicsarQuantumSyncCtrl& ctrl)
+    {
+        namespace abl_ser = ablastr::utils::serialization;
+        auto raw_params = std::vector<char>{};
+        abl_ser::put_in(std::string{"qed_qs"}, raw_params);
+        abl_ser::put_in(static_cast<int>(sizeof(amrex::ParticleReal)), raw_params);
+        abl_ser::put_in(ctrl.dndt_params.chi_part_min, raw_params);
+        abl_ser::put_in(ctrl.dndt_params.chi_part_max, raw_params);
+        abl_ser::put_in(ctrl.dndt_params.chi_part_how_many, raw_params);
+        abl_ser::put_in(ctrl.phot_em_params.chi_part_min, raw_params);
+        abl_ser::put_in(ctrl.phot_em_params.chi_part_max, raw_params);
+        abl_ser::put_in(ctrl.phot_em_params.frac_min, raw_params);
+        abl_ser::put_in(ctrl.phot_em_params.chi_part_how_many, raw_params);
+        abl_ser::put_in(ctrl.phot_em_params.frac_how_many, raw_params);
+        return QedUtils::get_table_params_hash(raw_params);
+    }
+
+    /** Hash of the parameters of the Breit-Wheeler lookup tables, used for the table cache */
+    std::string GetBreitWheelerTableHash (const PicsarBreitWheelerCtrl& ctrl)
+    {
+        namespace abl_ser = ablastr::utils::serialization;
+        auto raw_params = std::vector<char>{};
+        abl_ser::put_in(std::string{"qed_bw"}, raw_params);
+        abl_ser::put_in(static_cast<int>(sizeof(amrex::ParticleReal)), raw_params);
+        abl_ser::put_in(ctrl.dndt_params.chi_phot_min, raw_params);
+        abl_ser::put_in(ctrl.dndt_params.chi_phot_max, raw_params);
+        abl_ser::put_in(ctrl.dndt_params.chi_phot_how_many, raw_params);
+        abl_ser::put_in(ctrl.pair_prod_params.chi_phot_min, raw_params);
+        abl_ser::put_in(ctrl.pair_prod_params.chi_phot_max, raw_params);
+        abl_ser::put_in(ctrl.pair_prod_params.chi_phot_how_many, raw_params);
+        abl_ser::put_in(ctrl.pair_prod_params.frac_how_many, raw_params);
+        return QedUtils::get_table_params_hash(raw_params);
+    }
+
+    /** Writes a lookup table in the cache directory. The table is first written in a
+     *  temporary file and then renamed, so that concurrent runs never read a partial file. */
+    void WriteTableInCache (const std::string& cache_directory,
+        const std::string& cache_name, const amrex::Vector<char>& data)
+    {
+        constexpr int permission_flag_rwxrxrx = 0755;
+        if (!amrex::UtilCreateDirectory(cache_directory, permission_flag_rwxrxrx)) {
+            amrex::CreateDirectoryFailed(cache_directory);
+        }
+        const auto tmp_name = cache_name + ".tmp" + std::to_string(amrex::ParallelDescriptor::MyProc());
+        if (WarpXUtilIO::WriteBinaryDataOnFile(tmp_name, data)) {
+            std::rename(tmp_name.c_str(), cache_name.c_str());
+        }
+    }
+
+    /** Copies a lookup table found in the cache to the file requested with save_table_in
+     *  (on the I/O processor only), so that it can be loaded by later runs */
+    void CopyTableFromCache (const std::string& cache_name, const std::string& table_name)
+    {
+        if (table_name.empty() || !amrex::ParallelDescriptor::IOProcessor()) { return; }
+        std::error_code ec;
+        std::filesystem::copy_file(cache_name, table_name,
+            std::filesystem::copy_options::overwrite_existing, ec);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!ec,
+            "Failed to copy the QED table " + cache_name + " to " + table_name + ": " + ec.message());
+    }
+#endif
 }
 
 MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
@@ -961,10 +1031,11 @@ void MultiParticleContainer::CheckIonizationProductSpecies()
 }
 
 void MultiParticleContainer::ScrapeParticlesAtEB (
-    ablastr::fields::MultiLevelScalarField const& distance_to_eb)
+    ablastr::fields::MultiLevelScalarField const& distance_to_eb,
+    DistanceToEB::MultiLevelBoxTypes const& eb_box_types)
 {
     for (auto& pc : allcontainers) {
-        scrapeParticlesAtEB(*pc, distance_to_eb, ParticleBoundaryProcess::Absorb());
+        scrapeParticlesAtEB(*pc, distance_to_eb, ParticleBoundaryProcess::Absorb(), eb_box_types);
     }
 }
 
@@ -1031,6 +1102,11 @@ void MultiParticleContainer::InitQuantumSync ()
         WARPX_ABORT_WITH_MESSAGE("Quantum Synchrotron table mode should be provided");
     }
 
+    // If requested, the lookup tables are stored only once per compute node,
+    // in memory shared by all the MPI ranks of the node
+    bool node_shared_tables = false;
+    pp_qed_qs.query("node_shared_tables", node_shared_tables);
+
     if(lookup_table_mode == "generate"){
         ablastr::warn_manager::WMRecordWarning("QED",
             "A new Quantum Synchrotron table will be generated.",
@@ -1038,7 +1114,7 @@ void MultiParticleContainer::InitQuantumSync ()
 #ifndef WARPX_QED_TABLE_GEN
         WARPX_ABORT_WITH_MESSAGE("Error: Compile with QED_TABLE_GEN=TRUE to enable table generation!\n");
 #else
-        QuantumSyncGenerateTable();
+        QuantumSyncGenerateTable(node_shared_tables);
 #endif
     }
     else if(lookup_table_mode == "load"){
@@ -1051,10 +1127,18 @@ void MultiParticleContainer::InitQuantumSync ()
             WARPX_ABORT_WITH_MESSAGE("Quantum Synchrotron table name should be provided");
         }
         Vector<char> table_data;
-        ParallelDescriptor::ReadAndBcastFile(load_table_name, table_data);
-        ParallelDescriptor::Barrier();
-        m_shr_p_qs_engine->init_lookup_tables_from_raw_data(table_data,
-            qs_minimum_chi_part);
+        if(node_shared_tables){
+            ablastr::parallelization::read_and_bcast_file_to_node_leaders(
+                load_table_name, table_data);
+            m_shr_p_qs_engine->init_node_shared_lookup_tables(
+                table_data, qs_minimum_chi_part);
+        }
+        else{
+            ParallelDescriptor::ReadAndBcastFile(load_table_name, table_data);
+            ParallelDescriptor::Barrier();
+            m_shr_p_qs_engine->init_lookup_tables_from_raw_data(table_data,
+                qs_minimum_chi_part);
+        }
     }
     else if(lookup_table_mode == "builtin"){
         ablastr::warn_manager::WMRecordWarning("QED",
@@ -1062,6 +1146,10 @@ void MultiParticleContainer::InitQuantumSync ()
             "This low resolution table is intended for testing purposes only.",
             ablastr::warn_manager::WarnPriority::medium);
         m_shr_p_qs_engine->init_builtin_tables(qs_minimum_chi_part);
+        if(node_shared_tables){
+            m_shr_p_qs_engine->init_node_shared_lookup_tables(
+                m_shr_p_qs_engine->export_lookup_tables_data(), qs_minimum_chi_part);
+        }
     }
     else{
         WARPX_ABORT_WITH_MESSAGE("Unknown Quantum Synchrotron table mode");
@@ -1090,6 +1178,11 @@ void MultiParticleContainer::InitBreitWheeler ()
         WARPX_ABORT_WITH_MESSAGE("Breit Wheeler table mode should be provided");
     }
 
+    // If requested, the lookup tables are stored only once per compute node,
+    // in memory shared by all the MPI ranks of the node
+    bool node_shared_tables = false;
+    pp_qed_bw.query("node_shared_tables", node_shared_tables);
+
     if(lookup_table_mode == "generate"){
         ablastr::warn_manager::WMRecordWarning("QED",
             "A new Breit Wheeler table will be generated.",
@@ -1097,7 +1190,7 @@ void MultiParticleContainer::InitBreitWheeler ()
 #ifndef WARPX_QED_TABLE_GEN
         amrex::Error("Error: Compile with QED_TABLE_GEN=TRUE to enable table generation!\n");
 #else
-        BreitWheelerGenerateTable();
+        BreitWheelerGenerateTable(node_shared_tables);
 #endif
     }
     else if(lookup_table_mode == "load"){
@@ -1110,10 +1203,18 @@ void MultiParticleContainer::InitBreitWheeler ()
             WARPX_ABORT_WITH_MESSAGE("Breit Wheeler table name should be provided");
         }
         Vector<char> table_data;
-        ParallelDescriptor::ReadAndBcastFile(load_table_name, table_data);
-        ParallelDescriptor::Barrier();
-        m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
-            table_data, bw_minimum_chi_part);
+        if(node_shared_tables){
+            ablastr::parallelization::read_and_bcast_file_to_node_leaders(
+                load_table_name, table_data);
+            m_shr_p_bw_engine->init_node_shared_lookup_tables(
+                table_data, bw_minimum_chi_part);
+        }
+        else{
+            ParallelDescriptor::ReadAndBcastFile(load_table_name, table_data);
+            ParallelDescriptor::Barrier();
+            m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
+                table_data, bw_minimum_chi_part);
+        }
     }
     else if(lookup_table_mode == "builtin"){
         ablastr::warn_manager::WMRecordWarning("QED",
@@ -1121,6 +1222,10 @@ void MultiParticleContainer::InitBreitWheeler ()
             "This low resolution table is intended for testing purposes only.",
             ablastr::warn_manager::WarnPriority::medium);
         m_shr_p_bw_engine->init_builtin_tables(bw_minimum_chi_part);
+        if(node_shared_tables){
+            m_shr_p_bw_engine->init_node_shared_lookup_tables(
+                m_shr_p_bw_engine->export_lookup_tables_data(), bw_minimum_chi_part);
+        }
     }
     else{
         WARPX_ABORT_WITH_MESSAGE("Unknown Breit Wheeler table mode");
@@ -1132,14 +1237,20 @@ void MultiParticleContainer::InitBreitWheeler ()
 }
 
 void
-MultiParticleContainer::QuantumSyncGenerateTable ()
+MultiParticleContainer::QuantumSyncGenerateTable (const bool node_shared_tables)
 {
     const ParmParse pp_qed_qs("qed_qs");
     std::string table_name;
     pp_qed_qs.query("save_table_in", table_name);
+
+    // If a cache directory is provided, the generated table is also saved there,
+    // with a name depending on the table parameters, and it is reused by later runs
+    std::string cache_directory;
+    pp_qed_qs.query("table_cache_directory", cache_directory);
+
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        !table_name.empty(),
-        "qed_qs.save_table_in should be provided!");
+        !table_name.empty() || !cache_directory.empty(),
+        "qed_qs.save_table_in or qed_qs.table_cache_directory should be provided!");
 
     // qs_minimum_chi_part is the minimum chi parameter to be
     // considered for Synchrotron emission. If a lepton has chi < chi_min,
@@ -1147,89 +1258,132 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     amrex::Real qs_minimum_chi_part;
     utils::parser::getWithParser(pp_qed_qs, "chi_min", qs_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarQuantumSyncCtrl ctrl;
-
-        //==Table parameters==
-
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
-
-        //Minimun chi for the table. If a lepton has chi < tab_dndt_chi_min,
-        //chi is considered as if it were equal to tab_dndt_chi_min
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_dndt_chi_min", ctrl.dndt_params.chi_part_min);
-
-        //Maximum chi for the table. If a lepton has chi > tab_dndt_chi_max,
-        //chi is considered as if it were equal to tab_dndt_chi_max
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_dndt_chi_max", ctrl.dndt_params.chi_part_max);
-
-        //How many points should be used for chi in the table
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_dndt_how_many", ctrl.dndt_params.chi_part_how_many);
-        //------
-
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //photons.
-
-        //Minimun chi for the table. If a lepton has chi < tab_em_chi_min,
-        //chi is considered as if it were equal to tab_em_chi_min
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_chi_min", ctrl.phot_em_params.chi_part_min);
-
-        //Maximum chi for the table. If a lepton has chi > tab_em_chi_max,
-        //chi is considered as if it were equal to tab_em_chi_max
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_chi_max", ctrl.phot_em_params.chi_part_max);
-
-        //How many points should be used for chi in the table
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_chi_how_many", ctrl.phot_em_params.chi_part_how_many);
-
-        //The other axis of the table is the ratio between the quantum
-        //parameter of the emitted photon and the quantum parameter of the
-        //lepton. This parameter is the minimum ratio to consider for the table.
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_frac_min", ctrl.phot_em_params.frac_min);
-
-        //This parameter is the number of different points to consider for the second
-        //axis
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
-        //====================
-
-        m_shr_p_qs_engine->compute_lookup_tables(ctrl, qs_minimum_chi_part);
-        const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
+    PicsarQuantumSyncCtrl ctrl;
+
+    //==Table parameters==
+
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
+
+    //Minimun chi for the table. If a lepton has chi < tab_dndt_chi_min,
+    //chi is considered as if it were equal to tab_dndt_chi_min
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_dndt_chi_min", ctrl.dndt_params.chi_part_min);
+
+    //Maximum chi for the table. If a lepton has chi > tab_dndt_chi_max,
+    //chi is considered as if it were equal to tab_dndt_chi_max
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_dndt_chi_max", ctrl.dndt_params.chi_part_max);
+
+    //How many points should be used for chi in the table
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_dndt_how_many", ctrl.dndt_params.chi_part_how_many);
+    //------
+
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //photons.
+
+    //Minimun chi for the table. If a lepton has chi < tab_em_chi_min,
+    //chi is considered as if it were equal to tab_em_chi_min
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_chi_min", ctrl.phot_em_params.chi_part_min);
+
+    //Maximum chi for the table. If a lepton has chi > tab_em_chi_max,
+    //chi is considered as if it were equal to tab_em_chi_max
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_chi_max", ctrl.phot_em_params.chi_part_max);
+
+    //How many points should be used for chi in the table
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_chi_how_many", ctrl.phot_em_params.chi_part_how_many);
+
+    //The other axis of the table is the ratio between the quantum
+    //parameter of the emitted photon and the quantum parameter of the
+    //lepton. This parameter is the minimum ratio to consider for the table.
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_frac_min", ctrl.phot_em_params.frac_min);
+
+    //This parameter is the number of different points to consider for the second
+    //axis
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
+    //====================
+
+    std::string cache_name;
+    bool found_in_cache = false;
+    if(!cache_directory.empty()){
+        cache_name = cache_directory + "/qed_qs_table_" + GetQuantumSyncTableHash(ctrl) + ".bin";
+        int cache_file_exists = ParallelDescriptor::IOProcessor() ?
+            static_cast<int>(amrex::FileExists(cache_name)) : 0;
+        ParallelDescriptor::Bcast(&cache_file_exists, 1,
+            ParallelDescriptor::IOProcessorNumber());
+        found_in_cache = (cache_file_exists != 0);
+    }
+
+    if(found_in_cache){
+        ablastr::warn_manager::WMRecordWarning("QED",
+            "The Quantum Synchrotron table will be read from the cache: " + cache_name,
+            ablastr::warn_manager::WarnPriority::low);
+        CopyTableFromCache(cache_name, table_name);
     }
+    else{
+        // all the MPI ranks take part in the generation of the table,
+        // which is then assembled on the I/O processor
+        m_shr_p_qs_engine->compute_lookup_tables_distributed(ctrl, qs_minimum_chi_part);
+
+        if(ParallelDescriptor::IOProcessor()){
+            const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
+            const auto vdata = Vector<char>{data.begin(), data.end()};
+            if(!table_name.empty()){
+                WarpXUtilIO::WriteBinaryDataOnFile(table_name, vdata);
+            }
+            if(!cache_directory.empty()){
+                WriteTableInCache(cache_directory, cache_name, vdata);
+            }
+        }
+    }
+
+    const auto& file_to_read = (found_in_cache || table_name.empty()) ?
+        cache_name : table_name;
 
     ParallelDescriptor::Barrier();
     Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
+    if(node_shared_tables){
+        ablastr::parallelization::read_and_bcast_file_to_node_leaders(
+            file_to_read, table_data);
+        m_shr_p_qs_engine->init_node_shared_lookup_tables(
+            table_data, qs_minimum_chi_part);
+        return;
+    }
+    ParallelDescriptor::ReadAndBcastFile(file_to_read, table_data);
     ParallelDescriptor::Barrier();
 
     //No need to initialize from raw data for the processor that
     //has just generated the table
-    if(!ParallelDescriptor::IOProcessor()){
+    if(!ParallelDescriptor::IOProcessor() || found_in_cache){
         m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
             table_data, qs_minimum_chi_part);
     }
 }
 
 void
-MultiParticleContainer::BreitWheelerGenerateTable ()
+MultiParticleContainer::BreitWheelerGenerateTable (const bool node_shared_tables)
 {
     const ParmParse pp_qed_bw("qed_bw");
     std::string table_name;
     pp_qed_bw.query("save_table_in", table_name);
+
+    // If a cache directory is provided, the generated table is also saved there,
+    // with a name depending on the table parameters, and it is reused by later runs
+    std::string cache_directory;
+    pp_qed_bw.query("table_cache_directory", cache_directory);
+
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        !table_name.empty(),
-        "qed_bw.save_table_in should be provided!");
+        !table_name.empty() || !cache_directory.empty(),
+        "qed_bw.save_table_in or qed_bw.table_cache_directory should be provided!");
 
     // bw_minimum_chi_phot is the minimum chi parameter to be
     // considered for pair production. If a photon has chi < chi_min,
@@ -1237,70 +1391,107 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     amrex::Real bw_minimum_chi_part;
     utils::parser::getWithParser(pp_qed_bw, "chi_min", bw_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarBreitWheelerCtrl ctrl;
-
-        //==Table parameters==
-
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
-
-        //Minimun chi for the table. If a photon has chi < tab_dndt_chi_min,
-        //an analytical approximation is used.
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_dndt_chi_min", ctrl.dndt_params.chi_phot_min);
-
-        //Maximum chi for the table. If a photon has chi > tab_dndt_chi_max,
-        //an analytical approximation is used.
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_dndt_chi_max", ctrl.dndt_params.chi_phot_max);
-
-        //How many points should be used for chi in the table
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_dndt_how_many", ctrl.dndt_params.chi_phot_how_many);
-        //------
-
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //particles.
-
-        //Minimun chi for the table. If a photon has chi < tab_pair_chi_min
-        //chi is considered as it were equal to chi_phot_tpair_min
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_pair_chi_min", ctrl.pair_prod_params.chi_phot_min);
-
-        //Maximum chi for the table. If a photon has chi > tab_pair_chi_max
-        //chi is considered as it were equal to chi_phot_tpair_max
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_pair_chi_max", ctrl.pair_prod_params.chi_phot_max);
-
-        //How many points should be used for chi in the table
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_pair_chi_how_many", ctrl.pair_prod_params.chi_phot_how_many);
-
-        //The other axis of the table is the fraction of the initial energy
-        //'taken away' by the most energetic particle of the pair.
-        //This parameter is the number of different fractions to consider
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
-        //====================
-
-        m_shr_p_bw_engine->compute_lookup_tables(ctrl, bw_minimum_chi_part);
-        const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
+    PicsarBreitWheelerCtrl ctrl;
+
+    //==Table parameters==
+
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
+
+    //Minimun chi for the table. If a photon has chi < tab_dndt_chi_min,
+    //an analytical approximation is used.
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_dndt_chi_min", ctrl.dndt_params.chi_phot_min);
+
+    //Maximum chi for the table. If a photon has chi > tab_dndt_chi_max,
+    //an analytical approximation is used.
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_dndt_chi_max", ctrl.dndt_params.chi_phot_max);
+
+    //How many points should be used for chi in the table
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_dndt_how_many", ctrl.dndt_params.chi_phot_how_many);
+    //------
+
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //particles.
+
+    //Minimun chi for the table. If a photon has chi < tab_pair_chi_min
+    //chi is considered as it were equal to chi_phot_tpair_min
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_pair_chi_min", ctrl.pair_prod_params.chi_phot_min);
+
+    //Maximum chi for the table. If a photon has chi > tab_pair_chi_max
+    //chi is considered as it were equal to chi_phot_tpair_max
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_pair_chi_max", ctrl.pair_prod_params.chi_phot_max);
+
+    //How many points should be used for chi in the table
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_pair_chi_how_many", ctrl.pair_prod_params.chi_phot_how_many);
+
+    //The other axis of the table is the fraction of the initial energy
+    //'taken away' by the most energetic particle of the pair.
+    //This parameter is the number of different fractions to consider
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
+    //====================
+
+    std::string cache_name;
+    bool found_in_cache = false;
+    if(!cache_directory.empty()){
+        cache_name = cache_directory + "/qed_bw_table_" + GetBreitWheelerTableHash(ctrl) + ".bin";
+        int cache_file_exists = ParallelDescriptor::IOProcessor() ?
+            static_cast<int>(amrex::FileExists(cache_name)) : 0;
+        ParallelDescriptor::Bcast(&cache_file_exists, 1,
+            ParallelDescriptor::IOProcessorNumber());
+        found_in_cache = (cache_file_exists != 0);
+    }
+
+    if(found_in_cache){
+        ablastr::warn_manager::WMRecordWarning("QED",
+            "The Breit Wheeler table will be read from the cache: " + cache_name,
+            ablastr::warn_manager::WarnPriority::low);
+        CopyTableFromCache(cache_name, table_name);
     }
+    else{
+        // all the MPI ranks take part in the generation of the table,
+        // which is then assembled on the I/O processor
+        m_shr_p_bw_engine->compute_lookup_tables_distributed(ctrl, bw_minimum_chi_part);
+
+        if(ParallelDescriptor::IOProcessor()){
+            const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
+            const auto vdata = Vector<char>{data.begin(), data.end()};
+            if(!table_name.empty()){
+                WarpXUtilIO::WriteBinaryDataOnFile(table_name, vdata);
+            }
+            if(!cache_directory.empty()){
+                WriteTableInCache(cache_directory, cache_name, vdata);
+            }
+        }
+    }
+
+    const auto& file_to_read = (found_in_cache || table_name.empty()) ?
+        cache_name : table_name;
 
     ParallelDescriptor::Barrier();
     Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
+    if(node_shared_tables){
+        ablastr::parallelization::read_and_bcast_file_to_node_leaders(
+            file_to_read, table_data);
+        m_shr_p_bw_engine->init_node_shared_lookup_tables(
+            table_data, bw_minimum_chi_part);
+        return;
+    }
+    ParallelDescriptor::ReadAndBcastFile(file_to_read, table_data);
     ParallelDescriptor::Barrier();
 
     //No need to initialize from raw data for the processor that
     //has just generated the table
-    if(!ParallelDescriptor::IOProcessor()){
+    if(!ParallelDescriptor::IOProcessor() || found_in_cache){
         m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
             table_data, bw_minimum_chi_part);
     }
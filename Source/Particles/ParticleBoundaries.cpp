@@ -70,6 +70,24 @@ ParticleBoundaries::CheckAll (ParticleBoundaryType bc) const
          && data.zmin_bc == bc && data.zmax_bc == bc);
 }
 
+bool
+ParticleBoundaries::CheckAny (ParticleBoundaryType bc) const
+{
+    return (data.xmin_bc == bc || data.xmax_bc == bc
+#ifdef WARPX_DIM_3D
+         || data.ymin_bc == bc || data.ymax_bc == bc
+#endif
+         || data.zmin_bc == bc || data.zmax_bc == bc);
+}
+
+bool
+ParticleBoundaries::HasReflectionModel () const
+{
+    return (reflection_model_xlo_str != "0.0" || reflection_model_xhi_str != "0.0"
+         || reflection_model_ylo_str != "0.0" || reflection_model_yhi_str != "0.0"
+         || reflection_model_zlo_str != "0.0" || reflection_model_zhi_str != "0.0");
+}
+
 void
 ParticleBoundaries::BuildReflectionModelParsers ()
 {
@@ -462,7 +462,8 @@ void ParticleBoundaryBuffer::gatherParticlesFromDomainBoundaries (MultiParticleC
 }
 
 void ParticleBoundaryBuffer::gatherParticlesFromEmbeddedBoundaries (
-    MultiParticleContainer& mypc, ablastr::fields::MultiLevelScalarField const& distance_to_eb)
+    MultiParticleContainer& mypc, ablastr::fields::MultiLevelScalarField const& distance_to_eb,
+    DistanceToEB::MultiLevelBoxTypes const& eb_box_types)
 {
     if (EB::enabled()) {
         WARPX_PROFILE("ParticleBoundaryBuffer::gatherParticles::EB");
@@ -505,6 +506,9 @@ void ParticleBoundaryBuffer::gatherParticlesFromEmbeddedBoundaries (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
                 for (PIter pti(pc, lev); pti.isValid(); ++pti) {
+                    // no particle can be inside the EB in the regular boxes
+                    if (DistanceToEB::skipBox(eb_box_types, lev, pti)) { continue; }
+
                     auto phiarr = (*distance_to_eb[lev])[pti].array();  // signed distance function
                     auto index = std::make_pair(pti.index(), pti.LocalTileIndex());
                     if (plevel.find(index) == plevel.end()) { continue; }
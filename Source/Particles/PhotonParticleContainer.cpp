@@ -166,8 +166,13 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
 
     const auto t_do_not_gather = do_not_gather;
 
+    // Moments of the pushed particles used by the particle reduced diagnostics
+    const auto pushMoments = GetPushMomentsAccumulator();
+    const ParticleReal* const AMREX_RESTRICT wp = attribs[PIdx::w].dataPtr() + offset;
+
     enum exteb_flags : int { no_exteb, has_exteb };
     enum qed_flags : int { no_qed, has_qed };
+    enum moments_flags : int { no_moments, has_moments };
 
     const int exteb_runtime_flag = getExternalEB.isNoOp() ? no_exteb : has_exteb;
 #ifdef WARPX_QED
@@ -175,13 +180,15 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
 #else
     const int qed_runtime_flag = no_qed;
 #endif
+    const int moments_runtime_flag = pushMoments.isNoOp() ? no_moments : has_moments;
 
     amrex::ParallelFor(TypeList<CompileTimeOptions<no_exteb,has_exteb>,
-                                CompileTimeOptions<no_qed  ,has_qed>>{},
-                       {exteb_runtime_flag, qed_runtime_flag},
+                                CompileTimeOptions<no_qed  ,has_qed>,
+                                CompileTimeOptions<no_moments,has_moments>>{},
+                       {exteb_runtime_flag, qed_runtime_flag, moments_runtime_flag},
                        np_to_push,
                        [=] AMREX_GPU_DEVICE (long i, auto exteb_control,
-                                             auto qed_control) {
+                                             auto qed_control, auto moments_control) {
             if (do_copy) { copyAttribs(i); }
             ParticleReal x, y, z;
             GetPosition(i, x, y, z);
@@ -224,6 +231,12 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
 
             UpdatePositionPhoton( x, y, z, ux[i], uy[i], uz[i], dt );
             SetPosition(i, x, y, z);
+
+            [[maybe_unused]] const auto& pushMoments_tmp = pushMoments; // workaround for nvcc
+            [[maybe_unused]] const auto* wp_tmp = wp;
+            if constexpr (moments_control == has_moments) {
+                pushMoments(i, wp[i], ux[i], uy[i], uz[i]);
+            }
         }
     );
 }
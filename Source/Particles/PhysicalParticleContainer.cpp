@@ -1325,7 +1325,7 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
         scrapeParticlesAtEB(
             *this,
             warpx.m_fields.get_mr_levels(FieldType::distance_to_eb, warpx.finestLevel()),
-            ParticleBoundaryProcess::Absorb());
+            ParticleBoundaryProcess::Absorb(), warpx.GetEBBoxTypes());
     }
 #endif
 
@@ -1793,7 +1793,7 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
         scrapeParticlesAtEB(
             tmp_pc,
             warpx.m_fields.get_mr_levels(FieldType::distance_to_eb, warpx.finestLevel()),
-            ParticleBoundaryProcess::Absorb());
+            ParticleBoundaryProcess::Absorb(), warpx.GetEBBoxTypes());
     }
 #endif
 
@@ -2540,6 +2540,13 @@ PhysicalParticleContainer::ContinuousFluxInjection (amrex::Real t, amrex::Real d
     }
 }
 
+bool
+PhysicalParticleContainer::doFluxInjection () const
+{
+    return std::any_of(plasma_injectors.begin(), plasma_injectors.end(),
+        [](auto const& plasma_injector) { return plasma_injector->doFluxInjection(); });
+}
+
 /* \brief Perform the field gather and particle push operations in one fused kernel
  *
  */
@@ -2668,8 +2675,13 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
 
     const auto t_do_not_gather = do_not_gather;
 
+    // Moments of the pushed particles used by the particle reduced diagnostics
+    const auto pushMoments = GetPushMomentsAccumulator();
+    const ParticleReal* const AMREX_RESTRICT wp = attribs[PIdx::w].dataPtr() + offset;
+
     enum exteb_flags : int { no_exteb, has_exteb };
     enum qed_flags : int { no_qed, has_qed };
+    enum moments_flags : int { no_moments, has_moments };
 
     const int exteb_runtime_flag = getExternalEB.isNoOp() ? no_exteb : has_exteb;
 #ifdef WARPX_QED
@@ -2677,15 +2689,17 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
 #else
     int qed_runtime_flag = no_qed;
 #endif
+    const int moments_runtime_flag = pushMoments.isNoOp() ? no_moments : has_moments;
 
     // Using this version of ParallelFor with compile time options
-    // improves performance when qed or external EB are not used by reducing
-    // register pressure.
+    // improves performance when qed, external EB or the moments are not used
+    // by reducing register pressure.
     amrex::ParallelFor(
-        TypeList<CompileTimeOptions<no_exteb,has_exteb>, CompileTimeOptions<no_qed  ,has_qed>>{},
-        {exteb_runtime_flag, qed_runtime_flag},
+        TypeList<CompileTimeOptions<no_exteb,has_exteb>, CompileTimeOptions<no_qed  ,has_qed>,
+                 CompileTimeOptions<no_moments,has_moments>>{},
+        {exteb_runtime_flag, qed_runtime_flag, moments_runtime_flag},
         np_to_push,
-        [=] AMREX_GPU_DEVICE (long ip, auto exteb_control, auto qed_control)
+        [=] AMREX_GPU_DEVICE (long ip, auto exteb_control, auto qed_control, auto moments_control)
     {
         amrex::ParticleReal xp, yp, zp;
         getPosition(ip, xp, yp, zp);
@@ -2779,6 +2793,12 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
 #else
             amrex::ignore_unused(qed_control);
 #endif
+
+        [[maybe_unused]] const auto& pushMoments_tmp = pushMoments; // workaround for nvcc
+        [[maybe_unused]] const auto* wp_tmp = wp;
+        if constexpr (moments_control == has_moments) {
+            pushMoments(ip, wp[ip], ux[ip], uy[ip], uz[ip]);
+        }
     });
 }
 
@@ -2888,6 +2908,16 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
         ion_lev = pti.GetiAttribs(particle_icomps["ionizationLevel"]).dataPtr() + offset;
     }
 
+    const int max_suborbits = WarpX::max_particle_suborbits_in_implicit_scheme;
+    const amrex::ParticleReal suborbit_gyro_phase = WarpX::particle_suborbit_gyro_phase;
+
+    // Number of suborbits of each particle, chosen at the first nonlinear iteration
+    // of the step (zero until then) and reused by the following ones
+    int* AMREX_RESTRICT nsub_p = nullptr;
+    if (max_suborbits > 1) {
+        nsub_p = pti.GetiAttribs(particle_icomps["nsub_implicit"]).dataPtr() + offset;
+    }
+
     // Loop over the particles and update their momentum
     const amrex::ParticleReal q = this->charge;
     const amrex::ParticleReal m = this-> mass;
@@ -2962,13 +2992,28 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
         auto idyg2 = static_cast<amrex::ParticleReal>(dinv.y*dinv.y);
         auto idzg2 = static_cast<amrex::ParticleReal>(dinv.z*dinv.z);
 
+        // Number of suborbits of this particle, and its velocity averaged over the suborbits
+        int nsub = (nsub_p && nsub_p[ip] > 0) ? nsub_p[ip] : 1;
+        amrex::ParticleReal vx_sub = 0._prt, vy_sub = 0._prt, vz_sub = 0._prt;
+
         amrex::ParticleReal step_norm = 1._prt;
         for (int iter=0; iter<max_iterations;) {
 
             dxp = 0.0;
             dyp = 0.0;
             dzp = 0.0;
-            UpdatePositionImplicit(dxp, dyp, dzp, ux_n[ip], uy_n[ip], uz_n[ip], ux[ip], uy[ip], uz[ip], 0.5_rt*dt);
+            if (nsub > 1 && iter > 0) {
+                // With suborbits, the displacement is the integral of the velocity along the orbit
+#if !defined(WARPX_DIM_1D_Z)
+                dxp = vx_sub*0.5_rt*dt;
+#endif
+#if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
+                dyp = vy_sub*0.5_rt*dt;
+#endif
+                dzp = vz_sub*0.5_rt*dt;
+            } else {
+                UpdatePositionImplicit(dxp, dyp, dzp, ux_n[ip], uy_n[ip], uz_n[ip], ux[ip], uy[ip], uz[ip], 0.5_rt*dt);
+            }
 #if !defined(WARPX_DIM_1D_Z)
             xp = xp_n + dxp;
 #endif
@@ -3011,36 +3056,75 @@ PhysicalParticleContainer::ImplicitPushXP (WarpXParIter& pti,
                 copyAttribs(ip);
             }
 
+            // Choose the number of suborbits from the gyro-phase advance over the step.
+            // It is fixed for the whole step, at the first Picard iteration of the first
+            // nonlinear iteration, so that the particle residual does not jump between
+            // the nonlinear iterations.
+            if (nsub_p && nsub_p[ip] == 0) {
+                constexpr amrex::ParticleReal inv_c2 = 1._prt/(PhysConst::c*PhysConst::c);
+                const amrex::ParticleReal gamma_n = std::sqrt(1._prt +
+                    (ux_n[ip]*ux_n[ip] + uy_n[ip]*uy_n[ip] + uz_n[ip]*uz_n[ip])*inv_c2);
+                const amrex::ParticleReal qp = (ion_lev ? ion_lev[ip] : 1)*q;
+                const amrex::ParticleReal Bp = std::sqrt(Bxp*Bxp + Byp*Byp + Bzp*Bzp);
+                const amrex::ParticleReal gyro_phase = std::abs(qp)*Bp*dt/(m*gamma_n);
+                const auto nsub_gyro = static_cast<int>(std::ceil(
+                    std::min(gyro_phase/suborbit_gyro_phase, static_cast<amrex::ParticleReal>(max_suborbits))));
+                nsub = amrex::max(1, amrex::min(nsub_gyro, max_suborbits));
+                nsub_p[ip] = nsub;
+            }
+            const amrex::Real dt_sub = dt/nsub;
+            vx_sub = 0._prt;
+            vy_sub = 0._prt;
+            vz_sub = 0._prt;
+
             // The momentum push starts with the velocity at the start of the step
             ux[ip] = ux_n[ip];
             uy[ip] = uy_n[ip];
             uz[ip] = uz_n[ip];
 
+            for (int isub = 0; isub < nsub; ++isub) {
+                const amrex::ParticleReal ux_old = ux[ip];
+                const amrex::ParticleReal uy_old = uy[ip];
+                const amrex::ParticleReal uz_old = uz[ip];
 #ifdef WARPX_QED
-            if (!do_sync)
+                if (!do_sync)
 #endif
-            {
-                doParticleMomentumPush<0>(ux[ip], uy[ip], uz[ip],
-                                          Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                                          ion_lev ? ion_lev[ip] : 1,
-                                          m, q, pusher_algo, do_crr,
-#ifdef WARPX_QED
-                                          t_chi_max,
-#endif
-                                          dt);
-            }
-#ifdef WARPX_QED
-            else {
-                if constexpr (qed_control == has_qed) {
-                    doParticleMomentumPush<1>(ux[ip], uy[ip], uz[ip],
+                {
+                    doParticleMomentumPush<0>(ux[ip], uy[ip], uz[ip],
                                               Exp, Eyp, Ezp, Bxp, Byp, Bzp,
                                               ion_lev ? ion_lev[ip] : 1,
                                               m, q, pusher_algo, do_crr,
+#ifdef WARPX_QED
                                               t_chi_max,
-                                              dt);
+#endif
+                                              dt_sub);
+                }
+#ifdef WARPX_QED
+                else {
+                    if constexpr (qed_control == has_qed) {
+                        doParticleMomentumPush<1>(ux[ip], uy[ip], uz[ip],
+                                                  Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                                                  ion_lev ? ion_lev[ip] : 1,
+                                                  m, q, pusher_algo, do_crr,
+                                                  t_chi_max,
+                                                  dt_sub);
+                    }
                 }
-            }
 #endif
+                if (nsub > 1) {
+                    // Accumulate the time-centered velocity of the suborbit, with the
+                    // same average of the Lorentz factor as in UpdatePositionImplicit
+                    constexpr amrex::ParticleReal inv_c2 = 1._prt/(PhysConst::c*PhysConst::c);
+                    const amrex::ParticleReal gamma_old = std::sqrt(1._prt +
+                        (ux_old*ux_old + uy_old*uy_old + uz_old*uz_old)*inv_c2);
+                    const amrex::ParticleReal gamma_new = std::sqrt(1._prt +
+                        (ux[ip]*ux[ip] + uy[ip]*uy[ip] + uz[ip]*uz[ip])*inv_c2);
+                    const amrex::ParticleReal weight = 1._prt/((gamma_old + gamma_new)*nsub);
+                    vx_sub += (ux_old + ux[ip])*weight;
+                    vy_sub += (uy_old + uy[ip])*weight;
+                    vz_sub += (uz_old + uz[ip])*weight;
+                }
+            }
 
 #ifdef WARPX_QED
             [[maybe_unused]] auto foo_local_has_quantum_sync = local_has_quantum_sync;
@@ -43,6 +43,7 @@
 #include <AMReX_GpuAtomic.H>
 #include <AMReX_GpuControl.H>
 #include <AMReX_GpuDevice.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IndexType.H>
@@ -72,6 +73,7 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 
 using namespace amrex;
@@ -308,7 +310,7 @@ WarpXParticleContainer::AddNParticles (int /*lev*/, long n,
         scrapeParticlesAtEB(
             *this,
             warpx.m_fields.get_mr_levels(FieldType::distance_to_eb, warpx.finestLevel()),
-            ParticleBoundaryProcess::Absorb());
+            ParticleBoundaryProcess::Absorb(), warpx.GetEBBoxTypes());
         deleteInvalidParticles();
     }
 #endif
@@ -328,6 +330,71 @@ WarpXParticleContainer::deleteInvalidParticles () {
     }
 }
 
+void
+WarpXParticleContainer::SetAccumulatePushMoments (bool accumulate)
+{
+    // The sums are taken right after the push. Fall back to a separate loop over the
+    // particles for the species that are not pushed, and for those whose momenta or
+    // number change before the reduced diagnostics are computed (removal at absorbing
+    // or open boundaries, reflections at the boundaries, thermal boundaries,
+    // flux injection, resampling)
+    m_accumulate_push_moments = accumulate && !do_not_push
+        && !m_boundary_conditions.CheckAny(ParticleBoundaryType::Absorbing)
+        && !m_boundary_conditions.CheckAny(ParticleBoundaryType::Open)
+        && !m_boundary_conditions.CheckAny(ParticleBoundaryType::Reflecting)
+        && !m_boundary_conditions.CheckAny(ParticleBoundaryType::Thermal)
+        && !m_boundary_conditions.HasReflectionModel()
+        && !doFluxInjection() && !do_resampling;
+    if (!m_accumulate_push_moments) { return; }
+
+#if defined(AMREX_USE_GPU)
+    // Number of copies of the sums, over which the atomics of the GPU threads are spread
+    m_push_moments_nslots = 256;
+#elif defined(AMREX_USE_OMP)
+    // One copy of the sums per OpenMP thread
+    m_push_moments_nslots = omp_get_max_threads();
+#else
+    m_push_moments_nslots = 1;
+#endif
+    m_push_moments.resize(m_push_moments_nslots*PushMomentIdx::nattribs);
+    amrex::Real* const AMREX_RESTRICT p_moments = m_push_moments.dataPtr();
+    amrex::ParallelFor(static_cast<int>(m_push_moments.size()),
+        [=] AMREX_GPU_DEVICE (int i) { p_moments[i] = 0._rt; });
+}
+
+std::array<amrex::Real, PushMomentIdx::nattribs>
+WarpXParticleContainer::GetPushMoments () const
+{
+    std::array<amrex::Real, PushMomentIdx::nattribs> moments {};
+    if (!m_accumulate_push_moments) { return moments; }
+
+    amrex::Vector<amrex::Real> h_moments(m_push_moments.size());
+    amrex::Gpu::copy(amrex::Gpu::deviceToHost,
+        m_push_moments.begin(), m_push_moments.end(), h_moments.begin());
+    for (int islot = 0; islot < m_push_moments_nslots; ++islot) {
+        for (int icomp = 0; icomp < PushMomentIdx::nattribs; ++icomp) {
+            moments[icomp] += h_moments[islot*PushMomentIdx::nattribs + icomp];
+        }
+    }
+    return moments;
+}
+
+PushMomentsAccumulator
+WarpXParticleContainer::GetPushMomentsAccumulator ()
+{
+    PushMomentsAccumulator accumulator;
+    if (!m_accumulate_push_moments) { return accumulator; }
+
+    accumulator.m_sums = m_push_moments.dataPtr();
+    accumulator.m_nslots = m_push_moments_nslots;
+#if defined(AMREX_USE_OMP) && !defined(AMREX_USE_GPU)
+    accumulator.m_slot = omp_get_thread_num();
+#endif
+    accumulator.m_mass = mass;
+    accumulator.m_is_photon = AmIA<PhysicalSpecies::photon>();
+    return accumulator;
+}
+
 /* \brief Current Deposition for thread thread_num
  * \param pti         Particle iterator
  * \param wp          Array of particle weights
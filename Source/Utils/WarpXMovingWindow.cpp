@@ -52,6 +52,8 @@
 
 #include <array>
 #include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <memory>
 #include <string>
 
@@ -484,26 +486,26 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
     using namespace amrex::literals;
     WARPX_PROFILE("WarpX::shiftMF()");
     const amrex::BoxArray& ba = mf.boxArray();
-    const amrex::DistributionMapping& dm = mf.DistributionMap();
     const int nc = mf.nComp();
     const amrex::IntVect& ng = mf.nGrowVect();
 
     AMREX_ALWAYS_ASSERT(ng[dir] >= num_shift);
 
-    amrex::MultiFab tmpmf(ba, dm, nc, ng);
-    amrex::MultiFab::Copy(tmpmf, mf, 0, 0, nc, ng);
-
+    // The field is shifted in place: the guard cells are filled with the data
+    // of the neighboring boxes (and, below, with the data of the region that
+    // the window moved into), so that each box can then be shifted locally
+    // without a temporary copy of the whole MultiFab.
     if ( WarpX::safe_guard_cells ) {
         // Fill guard cells.
-        ablastr::utils::communication::FillBoundary(tmpmf, WarpX::do_single_precision_comms, geom.periodicity());
+        ablastr::utils::communication::FillBoundary(mf, WarpX::do_single_precision_comms, geom.periodicity());
     } else {
         amrex::IntVect ng_mw = amrex::IntVect::TheUnitVector();
         // Enough guard cells in the MW direction
-        ng_mw[dir] = num_shift;
+        ng_mw[dir] = std::abs(num_shift);
         // Make sure we don't exceed number of guard cells allocated
         ng_mw = ng_mw.min(ng);
         // Fill guard cells.
-        ablastr::utils::communication::FillBoundary(tmpmf, ng_mw, WarpX::do_single_precision_comms, geom.periodicity());
+        ablastr::utils::communication::FillBoundary(mf, ng_mw, WarpX::do_single_precision_comms, geom.periodicity());
     }
 
     // Make a box that covers the region that the window moved into
@@ -537,12 +539,21 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
     const amrex::RealBox& real_box = geom.ProbDomain();
     const auto dx = geom.CellSizeArray();
 
+    // Tiles span the whole boxes along the moving direction,
+    // such that each line of cells along dir is shifted by a single thread
+    amrex::MFItInfo mfi_info;
+    if (amrex::TilingIfNotGPU()) {
+        amrex::IntVect tile_size = amrex::FabArrayBase::mfiter_tile_size;
+        tile_size[dir] = std::numeric_limits<int>::max()/2;
+        mfi_info.EnableTiling(tile_size);
+    }
+
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
 
-    for (amrex::MFIter mfi(tmpmf, TilingIfNotGPU()); mfi.isValid(); ++mfi )
+    for (amrex::MFIter mfi(mf, mfi_info); mfi.isValid(); ++mfi )
     {
         if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
         {
@@ -550,8 +561,7 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
         }
         auto wt = static_cast<amrex::Real>(amrex::second());
 
-        auto const& dstfab = mf.array(mfi);
-        auto const& srcfab = tmpmf.array(mfi);
+        auto const& fab = mf.array(mfi);
 
         const amrex::Box& outbox = mfi.growntilebox() & adjBox;
 
@@ -559,11 +569,11 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
             if (!useparser) {
                 AMREX_PARALLEL_FOR_4D ( outbox, nc, i, j, k, n,
                 {
-                    srcfab(i,j,k,n) = external_field;
+                    fab(i,j,k,n) = external_field;
                 })
             } else {
                 // index type of the src mf
-                auto const& mf_IndexType = (tmpmf).ixType();
+                auto const& mf_IndexType = mf.ixType();
                 amrex::IntVect mf_type(AMREX_D_DECL(0,0,0));
                 for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
                     mf_type[idim] = mf_IndexType.nodeCentered(idim);
@@ -592,22 +602,42 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
                       const amrex::Real fac_z = (1.0_rt - mf_type[2]) * dx[2]*0.5_rt;
                       const amrex::Real z = k*dx[2] + real_box.lo(2) + fac_z;
 #endif
-                      srcfab(i,j,k,n) = field_parser(x,y,z);
+                      fab(i,j,k,n) = field_parser(x,y,z);
                 });
             }
 
         }
 
-        amrex::Box dstBox = mf[mfi].box();
+        amrex::Box dstBox = mfi.growntilebox();
         if (num_shift > 0) {
             dstBox.growHi(dir, -num_shift);
         } else {
             dstBox.growLo(dir,  num_shift);
         }
-        AMREX_PARALLEL_FOR_4D ( dstBox, nc, i, j, k, n,
+        const int dst_lo = dstBox.smallEnd(dir);
+        const int dst_hi = dstBox.bigEnd(dir);
+
+        // Each work item shifts one line of cells along dir, in the order
+        // in which no value is overwritten before it has been read
+        amrex::Box lineBox = dstBox;
+        lineBox.setRange(dir, dst_lo);
+        amrex::ParallelFor(lineBox, nc,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
         {
-            dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
-        })
+            amrex::Dim3 cell{i, j, k};
+            int& c = (dir == 0) ? cell.x : ((dir == 1) ? cell.y : cell.z);
+            if (num_shift > 0) {
+                for (int m = dst_lo; m <= dst_hi; ++m) {
+                    c = m;
+                    fab(cell.x,cell.y,cell.z,n) = fab(cell.x+shift.x,cell.y+shift.y,cell.z+shift.z,n);
+                }
+            } else {
+                for (int m = dst_hi; m >= dst_lo; --m) {
+                    c = m;
+                    fab(cell.x,cell.y,cell.z,n) = fab(cell.x+shift.x,cell.y+shift.y,cell.z+shift.z,n);
+                }
+            }
+        });
 
         if (cost && update_cost_flag &&
             WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
@@ -636,7 +666,7 @@ WarpX::shiftMF (amrex::MultiFab& mf, const amrex::Geometry& geom,
             bl.push_back(amrex::grow(ba[i], 0, mf.nGrowVect()[0]));
         }
         const amrex::BoxArray rba(std::move(bl));
-        amrex::MultiFab rmf(rba, dm, mf.nComp(), IntVect(0,mf.nGrowVect()[1]), MFInfo().SetAlloc(false));
+        amrex::MultiFab rmf(rba, mf.DistributionMap(), mf.nComp(), IntVect(0,mf.nGrowVect()[1]), MFInfo().SetAlloc(false));
 
         for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi) {
             rmf.setFab(mfi, FArrayBox(mf[mfi], amrex::make_alias, 0, mf.nComp()));
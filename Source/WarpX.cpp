@@ -15,6 +15,7 @@
 #include "BoundaryConditions/PML.H"
 #include "Diagnostics/MultiDiagnostics.H"
 #include "Diagnostics/ReducedDiags/MultiReducedDiags.H"
+#include "EmbeddedBoundary/EBSparseData.H"
 #include "EmbeddedBoundary/Enabled.H"
 #include "EmbeddedBoundary/WarpXFaceInfoBox.H"
 #include "FieldSolver/ElectrostaticSolvers/ElectrostaticSolver.H"
@@ -117,6 +118,8 @@ Real WarpX::zmin_domain_boost_step_0 = 0._rt;
 
 int WarpX::max_particle_its_in_implicit_scheme = 21;
 ParticleReal WarpX::particle_tol_in_implicit_scheme = 1.e-10;
+int WarpX::max_particle_suborbits_in_implicit_scheme = 1;
+ParticleReal WarpX::particle_suborbit_gyro_phase = 0.5;
 bool WarpX::do_dive_cleaning = false;
 bool WarpX::do_divb_cleaning = false;
 bool WarpX::do_divb_cleaning_external = false;
@@ -326,6 +329,7 @@ WarpX::WarpX ()
     m_flag_info_face.resize(nlevs_max);
     m_flag_ext_face.resize(nlevs_max);
     m_borrowing.resize(nlevs_max);
+    m_eb_sparse_data.resize(nlevs_max);
 
     // Create Electrostatic Solver object if needed
     if ((WarpX::electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrame)
@@ -846,6 +850,18 @@ WarpX::ReadParameters ()
             "The Silver-Mueller boundary condition can only be used with the Yee solver.");
 
         utils::parser::queryWithParser(pp_warpx, "pml_ncell", pml_ncell);
+        // The depth of the PML can be reduced on some faces, e.g. where the
+        // outgoing radiation is weak, to save memory and communication
+        std::vector<int> ncell_lo(AMREX_SPACEDIM, pml_ncell);
+        std::vector<int> ncell_hi(AMREX_SPACEDIM, pml_ncell);
+        utils::parser::queryArrWithParser(pp_warpx, "pml_ncell_lo", ncell_lo, 0, AMREX_SPACEDIM);
+        utils::parser::queryArrWithParser(pp_warpx, "pml_ncell_hi", ncell_hi, 0, AMREX_SPACEDIM);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ncell_lo[idim] > 0 && ncell_hi[idim] > 0,
+                "warpx.pml_ncell_lo and warpx.pml_ncell_hi must be positive");
+            pml_ncell_lo[idim] = ncell_lo[idim];
+            pml_ncell_hi[idim] = ncell_hi[idim];
+        }
         utils::parser::queryWithParser(pp_warpx, "pml_delta", pml_delta);
         pp_warpx.query("pml_has_particles", pml_has_particles);
         pp_warpx.query("do_pml_j_damping", do_pml_j_damping);
@@ -2062,7 +2078,7 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
         WarpX::fft_do_time_averaging,
         ::isAnyBoundaryPML(field_boundary_lo, field_boundary_hi),
         WarpX::do_pml_in_domain,
-        WarpX::pml_ncell,
+        WarpX::pml_ncell_hi[0],
         this->refRatio(),
         use_filter,
         bilinear_filter.stencil_length_each_dir);
@@ -2332,16 +2348,6 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
                 AllocInitMultiFab(m_flag_ext_face[lev][2], amrex::convert(ba, Bz_nodal_flag), dm, ncomps,
                                   guard_cells.ng_FieldSolver, lev, "m_flag_ext_face[z]");
 
-                /** EB: area_mod contains the modified areas of the mesh faces, i.e. if a face is enlarged it
-                * contains the area of the enlarged face
-                * This is only used for the ECT solver.*/
-                m_fields.alloc_init(FieldType::area_mod, Direction{0}, lev, amrex::convert(ba, Bx_nodal_flag),
-                    dm, ncomps, guard_cells.ng_FieldSolver, 0.0_rt);
-                m_fields.alloc_init(FieldType::area_mod, Direction{1}, lev, amrex::convert(ba, By_nodal_flag),
-                    dm, ncomps, guard_cells.ng_FieldSolver, 0.0_rt);
-                m_fields.alloc_init(FieldType::area_mod, Direction{2}, lev, amrex::convert(ba, Bz_nodal_flag),
-                    dm, ncomps, guard_cells.ng_FieldSolver, 0.0_rt);
-
                 m_borrowing[lev][0] = std::make_unique<amrex::LayoutData<FaceInfoBox>>(
                         amrex::convert(ba, Bx_nodal_flag), dm);
                 m_borrowing[lev][1] = std::make_unique<amrex::LayoutData<FaceInfoBox>>(
@@ -2349,16 +2355,6 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
                 m_borrowing[lev][2] = std::make_unique<amrex::LayoutData<FaceInfoBox>>(
                         amrex::convert(ba, Bz_nodal_flag), dm);
 
-                /** Venl contains the electromotive force for every mesh face, i.e. every entry is
-                * the corresponding entry in ECTRhofield multiplied by the total area (possibly with enlargement)
-                * This is only used for the ECT solver.*/
-                m_fields.alloc_init(FieldType::Venl, Direction{0}, lev, amrex::convert(ba, Bx_nodal_flag),
-                    dm, ncomps, guard_cells.ng_FieldSolver, 0.0_rt);
-                m_fields.alloc_init(FieldType::Venl, Direction{1}, lev, amrex::convert(ba, By_nodal_flag),
-                    dm, ncomps, guard_cells.ng_FieldSolver, 0.0_rt);
-                m_fields.alloc_init(FieldType::Venl, Direction{2}, lev, amrex::convert(ba, Bz_nodal_flag),
-                    dm, ncomps, guard_cells.ng_FieldSolver, 0.0_rt);
-
                 /** ECTRhofield is needed only by the ect
                 * solver and it contains the electromotive force density for every mesh face.
                 * The name ECTRhofield has been used to comply with the notation of the paper
@@ -2462,7 +2458,7 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
         if (field_boundary_hi[0] == FieldBoundaryType::PML && !do_pml_in_domain) {
             // Extend region that is solved for to include the guard cells
             // which is where the PML boundary is applied.
-            realspace_ba.growHi(0, pml_ncell);
+            realspace_ba.growHi(0, pml_ncell_hi[0]);
         }
         AllocLevelSpectralSolverRZ(spectral_solver_fp,
                                    lev,
@@ -2675,7 +2671,7 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
             if (field_boundary_hi[0] == FieldBoundaryType::PML && !do_pml_in_domain) {
                 // Extend region that is solved for to include the guard cells
                 // which is where the PML boundary is applied.
-                c_realspace_ba.growHi(0, pml_ncell);
+                c_realspace_ba.growHi(0, pml_ncell_hi[0]);
             }
             AllocLevelSpectralSolverRZ(spectral_solver_cp,
                                        lev,
@@ -28,41 +28,36 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_REAL.H>
 
+#include <array>
+#include <cmath>
+#include <memory>
+
+namespace
+{
+    /** Distributed FFT solver of the open boundary problem, together with the
+     *  parameters that it was set up for. The solver stores the Green function
+     *  in spectral space, on the doubled domain. */
+    struct IGFSolverCache
+    {
+        std::unique_ptr<amrex::FFT::OpenBCSolver<amrex::Real>> solver;
+        amrex::Box domain;
+        std::array<amrex::Real, 3> cell_size{};
+        bool is_igf_2d_slices = false;
+        int nprocs = 0;
+    };
+}
+
 namespace ablastr::fields {
 
 void
-computePhiIGF ( amrex::MultiFab const & rho,
-                amrex::MultiFab & phi,
-                std::array<amrex::Real, 3> const & cell_size,
-                amrex::BoxArray const & ba,
-                bool const is_igf_2d_slices)
+setIGFGreensFunction (amrex::FFT::OpenBCSolver<amrex::Real> & obc_solver,
+                      amrex::Box const & domain,
+                      std::array<amrex::Real, 3> const & cell_size,
+                      bool const is_igf_2d_slices)
 {
     using namespace amrex::literals;
 
-    BL_PROFILE("ablastr::fields::computePhiIGF");
-
-    // Define box that encompasses the full domain
-    amrex::Box domain = ba.minimalBox();
-    domain.surroundingNodes(); // get nodal points, since `phi` and `rho` are nodal
-    domain.grow( phi.nGrowVect() ); // include guard cells
-
-    int nprocs = amrex::ParallelDescriptor::NProcs();
-    {
-        amrex::ParmParse pp("ablastr");
-        pp.queryAdd("nprocs_igf_fft", nprocs);
-        nprocs = std::max(1,std::min(nprocs, amrex::ParallelDescriptor::NProcs()));
-    }
-
-    static std::unique_ptr<amrex::FFT::OpenBCSolver<amrex::Real>> obc_solver;
-    if (!obc_solver) {
-        amrex::ExecOnFinalize([&] () { obc_solver.reset(); });
-    }
-    if (!obc_solver || obc_solver->Domain() != domain) {
-        amrex::FFT::Info info{};
-        if (is_igf_2d_slices) { info.setBatchMode(true); } // do 2D FFTs
-        info.setNumProcs(nprocs);
-        obc_solver = std::make_unique<amrex::FFT::OpenBCSolver<amrex::Real>>(domain, info);
-    }
+    BL_PROFILE("ablastr::fields::setIGFGreensFunction");
 
     auto const& lo = domain.smallEnd();
     amrex::Real const dx = cell_size[0];
@@ -71,7 +66,7 @@ computePhiIGF ( amrex::MultiFab const & rho,
 
     if (!is_igf_2d_slices){
         // fully 3D solver
-        obc_solver->setGreensFunction(
+        obc_solver.setGreensFunction(
         [=] AMREX_GPU_DEVICE (int i, int j, int k) -> amrex::Real
         {
             int const i0 = i - lo[0];
@@ -85,7 +80,7 @@ computePhiIGF ( amrex::MultiFab const & rho,
         });
     }else{
         // 2D sliced solver
-        obc_solver->setGreensFunction(
+        obc_solver.setGreensFunction(
         [=] AMREX_GPU_DEVICE (int i, int j, int k) -> amrex::Real
         {
             int const i0 = i - lo[0];
@@ -98,6 +93,68 @@ computePhiIGF ( amrex::MultiFab const & rho,
         });
 
     }
+} // setIGFGreensFunction
+
+void
+computePhiIGF ( amrex::MultiFab const & rho,
+                amrex::MultiFab & phi,
+                std::array<amrex::Real, 3> const & cell_size,
+                amrex::BoxArray const & ba,
+                bool const is_igf_2d_slices)
+{
+    using namespace amrex::literals;
+
+    BL_PROFILE("ablastr::fields::computePhiIGF");
+
+    // Define box that encompasses the full domain
+    amrex::Box domain = ba.minimalBox();
+    domain.surroundingNodes(); // get nodal points, since `phi` and `rho` are nodal
+    domain.grow( phi.nGrowVect() ); // include guard cells
+
+    int nprocs = amrex::ParallelDescriptor::NProcs();
+    // relative change of the cell size below which the Green function is reused
+    amrex::Real green_function_rtol = 0._rt;
+    {
+        amrex::ParmParse pp("ablastr");
+        pp.queryAdd("nprocs_igf_fft", nprocs);
+        nprocs = std::max(1,std::min(nprocs, amrex::ParallelDescriptor::NProcs()));
+        pp.queryAdd("igf_green_function_rtol", green_function_rtol);
+    }
+
+    // The FFT solver is distributed over nprocs MPI ranks. It is only rebuilt when
+    // the domain or the solver options change, and the Green function, which is kept
+    // in spectral space, is only recomputed when the cell size changes by more than
+    // green_function_rtol (the cell size includes the Lorentz boost of the relativistic solver).
+    static IGFSolverCache igf_cache;
+    if (!igf_cache.solver) {
+        amrex::ExecOnFinalize([&] () { igf_cache.solver.reset(); });
+    }
+    bool const rebuild_solver = !igf_cache.solver ||
+                                igf_cache.domain != domain ||
+                                igf_cache.is_igf_2d_slices != is_igf_2d_slices ||
+                                igf_cache.nprocs != nprocs;
+    if (rebuild_solver) {
+        amrex::FFT::Info info{};
+        if (is_igf_2d_slices) { info.setBatchMode(true); } // do 2D FFTs
+        info.setNumProcs(nprocs);
+        igf_cache.solver = std::make_unique<amrex::FFT::OpenBCSolver<amrex::Real>>(domain, info);
+        igf_cache.domain = domain;
+        igf_cache.is_igf_2d_slices = is_igf_2d_slices;
+        igf_cache.nprocs = nprocs;
+    }
+    bool recompute_green_function = rebuild_solver;
+    for (int idim = 0; idim < 3; ++idim) {
+        amrex::Real const cached_dx = igf_cache.cell_size[idim];
+        if (std::abs(cell_size[idim] - cached_dx) > green_function_rtol*std::abs(cached_dx)) {
+            recompute_green_function = true;
+        }
+    }
+    auto& obc_solver = igf_cache.solver;
+
+    if (recompute_green_function) {
+        igf_cache.cell_size = cell_size;
+        setIGFGreensFunction(*obc_solver, domain, cell_size, is_igf_2d_slices);
+    }
 
     obc_solver->solve(phi, rho);
 } // computePhiIGF
@@ -0,0 +1,108 @@
+/* Copyright 2026 The ABLASTR Community
+ *
+ * This file is part of ABLASTR.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "NodeSharedBuffer.H"
+
+#include <AMReX_ParallelDescriptor.H>
+
+#include <cstddef>
+#include <string>
+
+
+namespace ablastr::parallelization
+{
+    bool
+    is_node_leader ()
+    {
+#if defined(AMREX_USE_MPI)
+        MPI_Comm node_comm = MPI_COMM_NULL;
+        MPI_Comm_split_type(amrex::ParallelDescriptor::Communicator(), MPI_COMM_TYPE_SHARED,
+                            amrex::ParallelDescriptor::MyProc(), MPI_INFO_NULL, &node_comm);
+        int node_rank = -1;
+        MPI_Comm_rank(node_comm, &node_rank);
+        MPI_Comm_free(&node_comm);
+        return node_rank == 0;
+#else
+        return true;
+#endif
+    }
+
+    void
+    read_and_bcast_file_to_node_leaders (std::string const& filename, amrex::Vector<char>& data)
+    {
+#if defined(AMREX_USE_MPI)
+        // the I/O processor has the lowest rank on its node and is thus a node leader
+        bool const leader = is_node_leader();
+        MPI_Comm leaders_comm = MPI_COMM_NULL;
+        MPI_Comm_split(amrex::ParallelDescriptor::Communicator(), leader ? 0 : MPI_UNDEFINED,
+                       amrex::ParallelDescriptor::MyProc(), &leaders_comm);
+        if (leader) {
+            amrex::ParallelDescriptor::ReadAndBcastFile(filename, data, true, leaders_comm);
+            MPI_Comm_free(&leaders_comm);
+        } else {
+            data.clear();
+        }
+#else
+        amrex::ParallelDescriptor::ReadAndBcastFile(filename, data);
+#endif
+    }
+
+    NodeSharedBuffer::NodeSharedBuffer (std::size_t nbytes)
+    {
+#if defined(AMREX_USE_MPI)
+        MPI_Comm_split_type(amrex::ParallelDescriptor::Communicator(), MPI_COMM_TYPE_SHARED,
+                            amrex::ParallelDescriptor::MyProc(), MPI_INFO_NULL, &m_node_comm);
+        int node_rank = -1;
+        MPI_Comm_rank(m_node_comm, &node_rank);
+        m_is_node_leader = (node_rank == 0);
+
+        // only the node leader allocates memory, the other ranks attach to it
+        auto const local_size = static_cast<MPI_Aint>(m_is_node_leader ? nbytes : 0);
+        void* local_ptr = nullptr;
+        MPI_Win_allocate_shared(local_size, 1, MPI_INFO_NULL, m_node_comm, &local_ptr, &m_win);
+
+        MPI_Aint leader_size = 0;
+        int disp_unit = 1;
+        void* leader_ptr = nullptr;
+        MPI_Win_shared_query(m_win, 0, &leader_size, &disp_unit, &leader_ptr);
+        m_data = static_cast<char*>(leader_ptr);
+        m_size = static_cast<std::size_t>(leader_size);
+
+        // passive target epoch for the lifetime of the buffer, see sync()
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, m_win);
+#else
+        m_local_data.resize(nbytes);
+        m_data = m_local_data.data();
+        m_size = nbytes;
+#endif
+    }
+
+    NodeSharedBuffer::~NodeSharedBuffer ()
+    {
+#if defined(AMREX_USE_MPI)
+        if (m_win != MPI_WIN_NULL) {
+            MPI_Win_unlock_all(m_win);
+            MPI_Win_free(&m_win);
+        }
+        if (m_node_comm != MPI_COMM_NULL) {
+            MPI_Comm_free(&m_node_comm);
+        }
+#endif
+    }
+
+    void
+    NodeSharedBuffer::sync ()
+    {
+#if defined(AMREX_USE_MPI)
+        // memory barriers around a process barrier, as required by the
+        // MPI-3 unified memory model for direct load/store accesses
+        MPI_Win_sync(m_win);
+        MPI_Barrier(m_node_comm);
+        MPI_Win_sync(m_win);
+#endif
+    }
+
+} // namespace ablastr::parallelization